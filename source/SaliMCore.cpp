@@ -10,27 +10,15 @@ SM_USE_NAMESPACE
 
 
 //Task support
-struct SmTaskBlock {
-    unsigned       mTopOfStack;
-    unsigned       mStackCellSize;
-    SmTaskBlock   *mNextTask;
-    void          *mArg;
-    SmWaitFunction mWaitFunction;
-    SmTaskFunction mTaskFunction;
-    bool           mCritic;
-
-    void buildTask( unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic );
-
-    void buildParialTask( void *arg, SmTaskFunction taskFunction, bool critic );
-
-    bool isApply( unsigned stackCellSize ) const { return mTopOfStack == 0 && (mStackCellSize == 0 || stackCellSize <= mStackCellSize); }
-
-    static bool criticUsed;
-  };
-
 using SmTaskBlockPtr = SmTaskBlock*;
 
-static SmTaskBlock taskBlock[SM_TASK_MAX];
+static SmTaskBlock mainTaskBlock;           //Block of main loop task
+#if SM_TASK_MAX > 0
+static SmTaskBlock taskBlock[SM_TASK_MAX];  //Pool of blocks for smTaskCreate
+#endif
+static int         taskIdCount;             //Count of created tasks for task index
+static SmTaskPeriodic *periodicHead;        //Release list of periodic tasks sorted by release moment
+static SmTaskBlock *suspendedHead;          //List of suspended tasks, which are not in task ring
 
 bool SmTaskBlock::criticUsed;
 
@@ -44,20 +32,96 @@ extern "C" {
   SmTaskBlockPtr smCurrentTask;
   SmTaskBlockPtr smNextTask;
 
+
+
+  //Excludes current task from task list and switches to next available task. Task excluded from list
+  //continues only when it included to list again
+  static void smTaskLeave()
+    {
+    smCurrentTask->unlink();
+    //Scan starts from next task of excluded one, which remains valid after unlink
+    for( smNextTask = smCurrentTask->mNextTask; !smNextTask->mWaitFunction( smNextTask->mArg ); smNextTask = smNextTask->mNextTask );
+    //Switch context
+    smPortSwitchContext();
+    }
+
   volatile int   smTickCount;
 
+  static volatile unsigned smTickHigh;   //High 32 bits of 64-bit tick count
+  static volatile unsigned smTickCycle;  //Cycle counter captured at last tick
+  static volatile unsigned smTickPeriod; //Count of cycles between two last ticks
+
 
   void smInit( unsigned stackCellSize )
     {
     //Copy current stack pointer to smTopStack
     smPortInitStack();
     //Init first task as main loop task
-    smCurrentTask = taskBlock;
-    smCurrentTask->mNextTask = smCurrentTask;
+    smCurrentTask = &mainTaskBlock;
+    smCurrentTask->mNextTask = smCurrentTask->mPrevTask = smCurrentTask;
     smCurrentTask->mTopOfStack = smTopStack;
+    smCurrentTask->mStackTop = smTopStack;
     smCurrentTask->mStackCellSize = stackCellSize;
     //Alloc stack for current main loop task
     smTopStack -= stackCellSize * 4;
+    //Start cycle counter for sub-tick time
+    smPortCycleInit();
+    smTickCycle = smPortCycleCount();
+#if SM_HOG_DETECTOR
+    smCurrentTask->sliceBegin();
+#endif
+    }
+
+
+
+  void smTickIsr( void )
+    {
+    //Increment tick count and extend it to 64 bits
+    unsigned tick = static_cast<unsigned>(smTickCount) + 1;
+    if( tick == 0 ) smTickHigh++;
+    smTickCount = static_cast<int>(tick);
+    //Capture cycle counter at tick and measure tick period in cycles
+    unsigned cycle = smPortCycleCount();
+    smTickPeriod = cycle - smTickCycle;
+    smTickCycle  = cycle;
+    }
+
+
+
+  int64_t smTickCount64( void )
+    {
+    unsigned high, tick;
+    //Repeat reading while tick changed by interrupt
+    do {
+      tick = static_cast<unsigned>(smTickCount);
+      high = smTickHigh;
+      }
+    while( tick != static_cast<unsigned>(smTickCount) );
+    return static_cast<int64_t>( (static_cast<uint64_t>(high) << 32) | tick );
+    }
+
+
+
+  int64_t smTimeUs( void )
+    {
+    unsigned high, tick, elapsed, period;
+    //Repeat reading while tick changed by interrupt
+    do {
+      tick    = static_cast<unsigned>(smTickCount);
+      high    = smTickHigh;
+      period  = smTickPeriod;
+      elapsed = smPortCycleCount() - smTickCycle;
+      }
+    while( tick != static_cast<unsigned>(smTickCount) );
+
+    //Convert cycles elapsed since tick into microseconds. When tick interrupt is pending elapsed may exceed period
+    unsigned us = 0;
+    if( period ) {
+      if( elapsed >= period ) elapsed = period - 1;
+      //Product is calculated in 64 bits: cycles per tick multiplied by tick period overflows 32 bits on long ticks
+      us = static_cast<unsigned>( static_cast<uint64_t>(elapsed) * SM_TICK_US / period );
+      }
+    return static_cast<int64_t>( (static_cast<uint64_t>(high) << 32) | tick ) * SM_TICK_US + us;
     }
 
 
@@ -65,18 +129,16 @@ extern "C" {
   void smTaskEntry(void)
     {
     while(true) {
+#if SM_HOG_DETECTOR
+      smCurrentTask->sliceBegin();
+#endif
       //Entry function must not return, but, if it return then exclude task from task list
       smCurrentTask->mTaskFunction( smCurrentTask->mArg );
 
-      //Exclude task from task list
-      for( smNextTask = smCurrentTask; smNextTask->mNextTask != smCurrentTask; smNextTask = smNextTask->mNextTask );
-      smNextTask->mNextTask = smCurrentTask->mNextTask;
-      smNextTask = smCurrentTask->mNextTask;
-
-      //Switch to next available task
-      for( smNextTask = smCurrentTask->mNextTask; !smNextTask->mWaitFunction( smNextTask->mArg ); smNextTask = smNextTask->mNextTask );
-      //Switch context
-      smPortSwitchContext();
+      //Block becomes free. Its stack is not used after switch, so it may be reused
+      smCurrentTask->mTaskFunction = nullptr;
+      //Exclude task from task list and switch to next available task
+      smTaskLeave();
       }
     }
 }
@@ -89,35 +151,60 @@ static bool smWaitAlwaysTrue( void* ) { return true; }
 
 void SmTaskBlock::buildTask(unsigned int stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic)
   {
-  //Entry function
-  mArg          = arg;
-  mWaitFunction = smWaitAlwaysTrue;
-  mTaskFunction = taskFunction;
-  //Stack
-  mTopOfStack = smTopStack;
-  smTopStack -= stackCellSize * 4;
+  //Stack is taken from main stack. Stack of reused block is taken again when it is large enough
+  if( stackCellSize > mStackCellSize ) {
+    mStackTop = smTopStack;
+    smTopStack -= stackCellSize * 4;
+    mStackCellSize = stackCellSize;
+    }
+  startTask( arg, taskFunction, critic );
+  }
+
+
+
+
+void SmTaskBlock::buildTask( unsigned *stack, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  //Stack grows down from end of caller-provided memory, top is aligned to 8 bytes
+  mStackTop      = static_cast<unsigned>( reinterpret_cast<uintptr_t>(stack + stackCellSize) ) & ~7u;
   mStackCellSize = stackCellSize;
-  //Critic
-  mCritic = critic;
-  //Link
-  mNextTask = smCurrentTask->mNextTask;
-  smCurrentTask->mNextTask = smNextTask = this;
+  startTask( arg, taskFunction, critic );
   }
 
 
 
 
-void SmTaskBlock::buildParialTask(void *arg, SmTaskFunction taskFunction, bool critic)
+void SmTaskBlock::startTask( void *arg, SmTaskFunction taskFunction, bool critic )
   {
   //Entry function
   mArg          = arg;
   mWaitFunction = smWaitAlwaysTrue;
   mTaskFunction = taskFunction;
+  //Stack
+  mTopOfStack = mStackTop;
   //Critic
   mCritic = critic;
+  if( critic ) criticUsed = true;
+  mSuspended = false;
+#if SM_EDF
+  mDeadlineSet  = false;
+  mDeadlineOpen = false;
+  mRelDeadline  = SM_EDF_NO_DEADLINE;
+  mDeadline     = smTickFuture( mRelDeadline );
+#endif
+  mId = ++taskIdCount;
+#if SM_HOG_DETECTOR
+  mMaxSlice = 0;
+#endif
+#if SM_WAKE_HISTOGRAM
+  //Histograms of previous task of this block are not actual
+  clearWakeHistogram();
+#endif
   //Link
-  mNextTask = smCurrentTask->mNextTask;
-  smCurrentTask->mNextTask = smNextTask = this;
+  linkAfter( smCurrentTask );
+  smNextTask = this;
+  //Build stack on smNextTask pointed task
+  smPortBuildStack();
   }
 
 
@@ -125,41 +212,223 @@ void SmTaskBlock::buildParialTask(void *arg, SmTaskFunction taskFunction, bool c
 
 
 
-void SM_NAMESPACE_PREPEND smTaskCreate(unsigned stackCellSize, void *arg, SmTaskFunction taskFunction , bool critic)
+SmTaskHandle SM_NAMESPACE_PREPEND smTaskCreate(unsigned stackCellSize, void *arg, SmTaskFunction taskFunction , bool critic)
   {
-  if( critic ) SmTaskBlock::criticUsed = true;
+#if SM_TASK_MAX > 0
+  //Free block with large enough stack is preferred, else block without stack
+  SmTaskBlock *block = nullptr;
   for( int i = 0; i < SM_TASK_MAX; i++ )
-    if( taskBlock[i].isApply(stackCellSize) ) {
-      if( taskBlock[i].mStackCellSize )
-        //Reused task block
-        taskBlock[i].buildParialTask( arg, taskFunction, critic );
-      else {
-        //Fill task block
-        taskBlock[i].buildTask( stackCellSize, arg, taskFunction, critic );
-        //Build stack on stNextTask pointed task
-        smPortBuildStack();
+    if( taskBlock[i].isFree() ) {
+      if( stackCellSize <= taskBlock[i].mStackCellSize ) {
+        block = taskBlock + i;
+        break;
         }
-      return;
+      if( block == nullptr && taskBlock[i].mStackCellSize == 0 )
+        block = taskBlock + i;
       }
+  if( block != nullptr )
+    block->buildTask( stackCellSize, arg, taskFunction, critic );
+  return block;
+#else
+  (void)stackCellSize; (void)arg; (void)taskFunction; (void)critic;
+  return nullptr;
+#endif
+  }
+
+
+
+
+SmTaskHandle SM_NAMESPACE_PREPEND smTaskCreate( SmTaskBlock *block, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  if( !block->isFree() )
+    return nullptr;
+  block->buildTask( stackCellSize, arg, taskFunction, critic );
+  return block;
+  }
+
+
+
+
+SmTaskHandle SM_NAMESPACE_PREPEND smTaskCreate( SmTaskBlock *block, unsigned *stack, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  if( !block->isFree() )
+    return nullptr;
+  block->buildTask( stack, stackCellSize, arg, taskFunction, critic );
+  return block;
+  }
+
+
+
+
+SmTaskHandle SM_NAMESPACE_PREPEND smTaskCurrent()
+  {
+  return smCurrentTask;
+  }
+
+
+
+
+SmTaskHandle SM_NAMESPACE_PREPEND smTaskFirst()
+  {
+  return &mainTaskBlock;
   }
 
 
 
 
+SmTaskHandle SM_NAMESPACE_PREPEND smTaskNext( SmTaskHandle task )
+  {
+  if( task->mSuspended )
+    return task->mNextSuspended;
+  //After last task of ring suspended tasks follow. Ring is not built before smInit
+  task = task->mNextTask;
+  return task != nullptr && task != &mainTaskBlock ? task : suspendedHead;
+  }
+
+
+
+
+//Excludes task from list of suspended tasks
+static void taskSuspendedRemove( SmTaskBlock *task )
+  {
+  SmTaskBlock **link = &suspendedHead;
+  while( *link != task ) link = &(*link)->mNextSuspended;
+  *link = task->mNextSuspended;
+  task->mNextSuspended = nullptr;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smTaskSuspend( SmTaskHandle task )
+  {
+  //Main loop task must remain in task list, free block is not in list
+  if( task == &mainTaskBlock || task->isFree() || task->mSuspended )
+    return;
+
+  task->mSuspended     = true;
+  task->mNextSuspended = suspendedHead;
+  suspendedHead        = task;
+  if( task == smCurrentTask ) {
+#if SM_HOG_DETECTOR
+    smCurrentTask->sliceEnd();
+#endif
+    //After resume task continues immediately
+    smCurrentTask->mWaitFunction = smWaitAlwaysTrue;
+    smTaskLeave();
+#if SM_HOG_DETECTOR
+    smCurrentTask->sliceBegin();
+#endif
+    }
+  else
+    task->unlink();
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smTaskResume( SmTaskHandle task )
+  {
+  if( !task->mSuspended )
+    return;
+  //Task continues its wait, so it runs when its wait function returns true
+  taskSuspendedRemove( task );
+  task->mSuspended = false;
+  task->linkAfter( smCurrentTask );
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smTaskTerminate( SmTaskHandle task )
+  {
+  //Main loop task can not be terminated
+  if( task == &mainTaskBlock || task->isFree() )
+    return;
+
+  //Terminated periodic task must not remain in release list
+  SmTaskPeriodic::unlink( task );
+  //Block becomes free. Its stack is not used after terminate, so it may be reused
+  task->mTaskFunction = nullptr;
+  if( task == smCurrentTask )
+    //Never returns
+    smTaskLeave();
+  else if( task->mSuspended ) {
+    taskSuspendedRemove( task );
+    task->mSuspended = false;
+    }
+  else
+    task->unlink();
+  }
+
+
+
+
+
+
+#if SM_EDF
+//Absolute deadline of current task for its wait. Relative deadline is stamped when task is found ready
+static void smTaskDeadlineUpdate()
+  {
+  smCurrentTask->mDeadlineOpen = !smCurrentTask->mDeadlineSet;
+  smCurrentTask->mDeadlineSet  = false;
+  }
+
+//Check if task has earlier deadline than best task found by scan
+static bool smTaskEarlier( SmTaskBlock *task, SmTaskBlock *best )
+  {
+  return best == smCurrentTask || static_cast<int>( static_cast<unsigned>(task->mDeadline) - static_cast<unsigned>(best->mDeadline) ) < 0;
+  }
+#endif
+
+
 
 
 void SM_NAMESPACE_PREPEND smWaitVoid(void *arg, SmWaitFunction waitFunction )
   {
+#if SM_HOG_DETECTOR
+  //Run slice of current task ends here
+  smCurrentTask->sliceEnd();
+#endif
+
   //Store wait functor for current task
   smCurrentTask->mArg          = arg;
   smCurrentTask->mWaitFunction = waitFunction;
 
+  //Release periodic tasks
+  if( periodicHead != nullptr )
+    smTaskPeriodicRelease();
+
+#if SM_EDF
+  smTaskDeadlineUpdate();
+#endif
+
   //First scan is for critic task
   if( SmTaskBlock::criticUsed ) {
+#if SM_EDF
+    //Select ready critic task with earliest deadline. Wait function is tested only for task with earlier deadline
+    //or task which deadline is not stamped yet
+    SmTaskBlock *best = smCurrentTask;
+    for( SmTaskBlock *task = smCurrentTask->mNextTask; task != smCurrentTask; task = task->mNextTask ) {
+      if( !task->mCritic ) continue;
+      if( task->mDeadlineOpen ) {
+        //Relative deadline is counted from moment when task is found ready, not from wait start
+        if( task->mWaitFunction( task->mArg ) ) {
+          task->mDeadline     = smTickFuture( task->mRelDeadline );
+          task->mDeadlineOpen = false;
+          if( smTaskEarlier( task, best ) ) best = task;
+          }
+        }
+      else if( smTaskEarlier( task, best ) && task->mWaitFunction( task->mArg ) )
+        best = task;
+      }
+    smNextTask = best;
+#else
     for( smNextTask = smCurrentTask->mNextTask; smNextTask != smCurrentTask; smNextTask = smNextTask->mNextTask )
       if( smNextTask->mCritic && smNextTask->mWaitFunction( smNextTask->mArg ) )
         //Available critic task found
         break;
+#endif
 
     if( smNextTask == smCurrentTask )
       //Scan task list for available task
@@ -174,6 +443,11 @@ void SM_NAMESPACE_PREPEND smWaitVoid(void *arg, SmWaitFunction waitFunction )
   if( smNextTask != smCurrentTask )
     //Switch context
     smPortSwitchContext();
+
+#if SM_HOG_DETECTOR
+  //Task resumed, new run slice begins
+  smCurrentTask->sliceBegin();
+#endif
   }
 
 
@@ -189,6 +463,46 @@ void SM_NAMESPACE_PREPEND smYeld()
 
 
 
+bool SM_NAMESPACE_PREPEND smYieldTo( SmTaskHandle task )
+  {
+  //When task is not ready, handoff is not possible and ring is scanned as usual.
+  //Main loop task has no task function, but its block is never free
+  if( task == smCurrentTask || (task != &mainTaskBlock && task->isFree()) || task->mSuspended || !task->mWaitFunction( task->mArg ) ) {
+    smYeld();
+    return false;
+    }
+
+#if SM_HOG_DETECTOR
+  //Run slice of current task ends here
+  smCurrentTask->sliceEnd();
+#endif
+
+  //Current task is ready to continue at any next scan
+  smCurrentTask->mArg          = nullptr;
+  smCurrentTask->mWaitFunction = smWaitAlwaysTrue;
+
+  //Release periodic tasks, so chain of handoffs does not delay releases
+  if( periodicHead != nullptr )
+    smTaskPeriodicRelease();
+
+#if SM_EDF
+  smTaskDeadlineUpdate();
+#endif
+
+  //Switch directly to task without scan
+  smNextTask = task;
+  smPortSwitchContext();
+
+#if SM_HOG_DETECTOR
+  //Task resumed, new run slice begins
+  smCurrentTask->sliceBegin();
+#endif
+  return true;
+  }
+
+
+
+
 
 
 void SM_NAMESPACE_PREPEND smWaitTick( int timeOut )
@@ -197,8 +511,364 @@ void SM_NAMESPACE_PREPEND smWaitTick( int timeOut )
   timeOut = smTickFuture( timeOut );
   //Wait this moment
   smWait<int>( &timeOut, [] ( int *timeOutArg ) -> bool { return smTickIsOut( *timeOutArg ); } );
+  smWakeRecordFuture( timeOut );
   }
 
 
 
 
+SmTaskPeriodic::SmTaskPeriodic() :
+  mNextRelease(nullptr),
+  mJob(nullptr),
+  mArg(nullptr),
+  mPeriod(0),
+  mRelease(0),
+  mReleased(false)
+  {
+  clearStatistics();
+  }
+
+
+
+
+void SmTaskPeriodic::clearStatistics()
+  {
+  mJobs      = 0;
+  mOverruns  = 0;
+  mJitterMin = 0xffffffffu;
+  mJitterMax = 0;
+  mJitterSum = 0;
+  }
+
+
+
+
+void SmTaskPeriodic::link()
+  {
+  //Insert task to release list sorted by release moment, after tasks with the same moment
+  SmTaskPeriodic **prev = &periodicHead;
+  while( *prev != nullptr && static_cast<int>( static_cast<unsigned>((*prev)->mRelease) - static_cast<unsigned>(mRelease) ) <= 0 )
+    prev = &(*prev)->mNextRelease;
+  mReleased    = false;
+  mNextRelease = *prev;
+  *prev        = this;
+  }
+
+
+
+
+void SmTaskPeriodic::unlink( SmTaskHandle task )
+  {
+  //Released task is not in list, so task may be absent
+  for( SmTaskPeriodic **prev = &periodicHead; *prev != nullptr; prev = &(*prev)->mNextRelease )
+    if( &(*prev)->mBlock == task ) {
+      *prev = (*prev)->mNextRelease;
+      return;
+      }
+  }
+
+
+
+
+void SmTaskPeriodic::taskEntry( void *arg )
+  {
+  SmTaskPeriodic *periodic = static_cast<SmTaskPeriodic*>(arg);
+  while(true) {
+#if SM_EDF
+    //Deadline of job is next release
+    smTaskSetDeadlineAt( static_cast<int>( static_cast<unsigned>(periodic->mRelease) + periodic->mPeriod ) );
+#endif
+    //Wait release. Scheduler releases task, so wait function only reads flag
+    smWait<SmTaskPeriodic>( periodic, [] ( SmTaskPeriodic *p ) -> bool { return p->mReleased; } );
+
+    //Delay of start after release in microseconds
+    int64_t releaseTick = smTickCount64() - static_cast<int>( static_cast<unsigned>(smTickCount) - static_cast<unsigned>(periodic->mRelease) );
+    int64_t jitter      = smTimeUs() - releaseTick * SM_TICK_US;
+    unsigned jitterUs   = jitter < 0 ? 0 : (jitter > 0xffffffffll ? 0xffffffffu : static_cast<unsigned>(jitter));
+    if( jitterUs < periodic->mJitterMin ) periodic->mJitterMin = jitterUs;
+    if( jitterUs > periodic->mJitterMax ) periodic->mJitterMax = jitterUs;
+    periodic->mJitterSum += jitterUs;
+
+    periodic->mJob( periodic->mArg );
+    periodic->mJobs++;
+
+    //Next release is locked to absolute ticks
+    periodic->mRelease = static_cast<int>( static_cast<unsigned>(periodic->mRelease) + periodic->mPeriod );
+    if( smTickIsOut( static_cast<int>( static_cast<unsigned>(periodic->mRelease) + 1 ) ) ) {
+      //Job completed after next release tick: next job starts immediately, completely missed releases are skipped
+      periodic->mOverruns++;
+      while( smTickIsOut( static_cast<int>( static_cast<unsigned>(periodic->mRelease) + periodic->mPeriod ) ) )
+        periodic->mRelease = static_cast<int>( static_cast<unsigned>(periodic->mRelease) + periodic->mPeriod );
+      }
+    periodic->link();
+    }
+  }
+
+
+
+
+SmTaskHandle SM_NAMESPACE_PREPEND smTaskCreatePeriodic( SmTaskPeriodic *periodic, unsigned stackCellSize, int period, int phase, SmTaskFunction job, void *arg, bool critic )
+  {
+  //Release moments would not advance with zero or negative period
+  if( period <= 0 ) return nullptr;
+  SmTaskHandle task = smTaskCreate( &periodic->mBlock, stackCellSize, periodic, SmTaskPeriodic::taskEntry, critic );
+  if( task == nullptr ) return nullptr;
+  //Task runs only after current task switches, so it is linked to release list before its first wait
+  periodic->mJob     = job;
+  periodic->mArg     = arg;
+  periodic->mPeriod  = period;
+  periodic->mRelease = smTickFuture( phase );
+  periodic->clearStatistics();
+  periodic->link();
+  return task;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smTaskPeriodicRelease()
+  {
+  //List is sorted, so only head is tested when nothing to release
+  while( periodicHead != nullptr && smTickIsOut(periodicHead->mRelease) ) {
+    periodicHead->mReleased = true;
+    periodicHead = periodicHead->mNextRelease;
+    }
+  }
+
+
+
+
+#if SM_EDF
+
+void SM_NAMESPACE_PREPEND smTaskSetDeadline( int tickOut )
+  {
+  smCurrentTask->mRelDeadline = tickOut;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smTaskSetDeadlineAt( int future )
+  {
+  smCurrentTask->mDeadline    = future;
+  smCurrentTask->mDeadlineSet = true;
+  }
+
+#endif
+
+
+
+
+#if SM_HOG_DETECTOR || SM_WAKE_HISTOGRAM
+
+//Finds task with index among all tasks including suspended ones
+static SmTaskBlock *taskFind( int task )
+  {
+  for( SmTaskBlock *block = &mainTaskBlock; block != nullptr; block = smTaskNext( block ) )
+    if( block->mId == task ) return block;
+  return nullptr;
+  }
+
+#endif
+
+
+
+
+#if SM_HOG_DETECTOR
+
+static unsigned      hogBudget;   //Budget of run slice in microseconds
+static SmHogFunction hogFunction; //Function called when task exceeds budget
+
+
+
+
+void SmTaskBlock::sliceEnd()
+  {
+  unsigned slice = static_cast<unsigned>( smTimeUs() ) - mSliceStart;
+  if( slice > mMaxSlice ) mMaxSlice = slice;
+  if( hogFunction && slice > hogBudget )
+    hogFunction( mId, slice );
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smHogBudget( unsigned budgetUs, SmHogFunction fun )
+  {
+  hogBudget   = budgetUs;
+  hogFunction = fun;
+  }
+
+
+
+
+unsigned SM_NAMESPACE_PREPEND smHogMaxSlice( int task )
+  {
+  SmTaskBlock *block = taskFind( task );
+  return block != nullptr ? block->mMaxSlice : 0;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smHogClear()
+  {
+  for( SmTaskBlock *block = &mainTaskBlock; block != nullptr; block = smTaskNext( block ) )
+    block->mMaxSlice = 0;
+  }
+
+#endif
+
+
+
+
+#if SM_WAKE_HISTOGRAM
+
+void SmTaskBlock::wakeRecord( int kind, int64_t latencyUs )
+  {
+  //Bucket is count of significant bits of latency, so bucket k covers [2^(k-1), 2^k)
+  int bucket = 0;
+  if( latencyUs > 0 )
+    bucket = latencyUs >= (static_cast<int64_t>(1) << (SM_WAKE_HISTOGRAM_BUCKETS - 1)) ? SM_WAKE_HISTOGRAM_BUCKETS - 1 : 32 - __builtin_clz( static_cast<unsigned>(latencyUs) );
+  //Saturate count
+  if( mWakeHistogram[kind][bucket] + 1 != 0 )
+    mWakeHistogram[kind][bucket]++;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smWakeRecordFuture( int future )
+  {
+  //Convert tick moment to microseconds relative to current tick. Low part of the same 64-bit snapshot is used
+  //as current tick, so tick between two readings can not skew result
+  int64_t tick64     = smTickCount64();
+  int64_t futureTick = tick64 - static_cast<int>( static_cast<unsigned>(tick64) - static_cast<unsigned>(future) );
+  smCurrentTask->wakeRecord( SM_WAKE_DEADLINE, smTimeUs() - futureTick * SM_TICK_US );
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smWakeRecordFutureUs( int64_t futureUs )
+  {
+  smCurrentTask->wakeRecord( SM_WAKE_DEADLINE, smTimeUs() - futureUs );
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smWakeRecordSignal( int64_t signalUs )
+  {
+  smCurrentTask->wakeRecord( SM_WAKE_SIGNAL, smTimeUs() - signalUs );
+  }
+
+
+
+
+static volatile int64_t wakeSignalUs = -1; //Moment of last smWaitSignal call
+
+//64-bit moment may be written by interrupt, so it is read under lock
+static int64_t wakeSignalLast()
+  {
+  SmIrqLocker locker;
+  return wakeSignalUs;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smWakeSignalMark()
+  {
+  int64_t now = smTimeUs();
+  SmIrqLocker locker;
+  wakeSignalUs = now;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smWakeRecordWait( int64_t beginUs )
+  {
+  int64_t signalUs = wakeSignalLast();
+  //Signal before wait began is not the event which resumed task
+  if( signalUs >= beginUs )
+    smCurrentTask->wakeRecord( SM_WAKE_SIGNAL, smTimeUs() - signalUs );
+  }
+
+
+
+
+unsigned SM_NAMESPACE_PREPEND smWakeHistogram( int task, int kind, int bucket )
+  {
+  SmTaskBlock *block = taskFind( task );
+  if( block == nullptr || kind < 0 || kind >= SM_WAKE_KINDS || bucket < 0 || bucket >= SM_WAKE_HISTOGRAM_BUCKETS )
+    return 0;
+  return block->mWakeHistogram[kind][bucket];
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smWakeHistogramClear()
+  {
+  for( SmTaskBlock *block = &mainTaskBlock; block != nullptr; block = smTaskNext( block ) )
+    block->clearWakeHistogram();
+  }
+
+
+
+
+static void wakeDumpString( void (*putChar)( char ch ), const char *str )
+  {
+  while( *str ) putChar( *str++ );
+  }
+
+
+
+
+static void wakeDumpUnsigned( void (*putChar)( char ch ), unsigned value )
+  {
+  char buf[10];
+  int  len = 0;
+  do {
+    buf[len++] = '0' + value % 10;
+    value /= 10;
+    }
+  while( value );
+  while( len ) putChar( buf[--len] );
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smWakeHistogramDump( void (*putChar)( char ch ) )
+  {
+  static const char *kindName[SM_WAKE_KINDS] = { " deadline", " signal" };
+  for( SmTaskBlock *block = &mainTaskBlock; block != nullptr; block = smTaskNext( block ) )
+    for( int kind = 0; kind < SM_WAKE_KINDS; kind++ ) {
+      bool empty = true;
+      for( int bucket = 0; bucket < SM_WAKE_HISTOGRAM_BUCKETS; bucket++ )
+        if( block->mWakeHistogram[kind][bucket] ) {
+          if( empty ) {
+            //Header of line
+            wakeDumpString( putChar, "task " );
+            wakeDumpUnsigned( putChar, block->mId );
+            wakeDumpString( putChar, kindName[kind] );
+            empty = false;
+            }
+          //Bucket lower bound and count
+          putChar( ' ' );
+          wakeDumpUnsigned( putChar, bucket ? 1u << (bucket - 1) : 0 );
+          putChar( ':' );
+          wakeDumpUnsigned( putChar, block->mWakeHistogram[kind][bucket] );
+          }
+      if( !empty ) putChar( '\n' );
+      }
+  }
+
+#endif
+
+
+
+
@@ -51,13 +51,40 @@
      v0.5  appended smWait_XXX_AndTime functions as waiting some event OR timeout exceed
      v0.6  appended smWaitTickUntil function
      v0.7  appended smWaitTickXXXHard functions
+     v0.8  appended table-driven CRC-8, CRC-16 and CRC-32 functions to SaliMUtils
+     v0.9  appended SmFixedPool template class as pool of fixed size blocks
+     v0.10 appended SmFixedChannel template class for zero-copy message passing
+     v0.11 appended SmFixedHeap template class as priority queue, SmLess and SmGreater comparators
+     v0.12 appended SmTimer software timers on hierarchical timing wheel (SaliMTimer)
+           smTickIsOut and smTickFuture calculate in unsigned arithmetic to be wrap-safe with optimization
+     v0.13 appended SmEventFlags event flag groups, SmIrqLocker and smPortIrqXXX port functions
+           fixed containers may post event flags on state changes (SM_FIXED_EVENTS)
+     v0.14 appended SmMutexFifo and SmSemaphorFifo with FIFO ownership handoff
+     v0.15 appended SmRwLock reader-writer lock with SmRwLockReadLocker and SmRwLockWriteLocker
+     v0.16 appended 64-bit time: smTickIsr, smTickCount64, smTimeUs, smWaitUs functions and smPortCycleXXX port functions
+     v0.17 appended wake-latency histograms (SM_WAKE_HISTOGRAM)
+     v0.18 appended hog detector of long run slices (SM_HOG_DETECTOR)
+     v0.19 appended smWaitSignal, FreeRTOS backend blocks waiting tasks instead of polling
+     v0.20 appended POSIX threads backend SaliMCorePosix
+     v0.21 appended caller-provided task blocks, SmTaskBlock moved to header
+     v0.22 appended caller-provided task stacks SmTaskStack
+     v0.23 appended earliest-deadline-first scheduling of critic tasks (SM_EDF)
+     v0.24 appended periodic tasks SmTaskPeriodic with drift-free release and overrun and jitter statistics
+     v0.25 appended task handles: smTaskCreate returns SmTaskHandle, smTaskSuspend, smTaskResume, smTaskTerminate
+     v0.26 appended direct task handoff smYieldTo
+     v0.27 appended broadcast ring SmFixedBroadcast with one writer and several readers
+     v0.28 appended sorted containers SmFixedSortedMap and SmFixedSortedSet, fixed SmFixedBuffer block insert
+     v0.29 appended hash map SmFixedHashMap with linear probing and hash function SmHash
+     v0.30 appended command line shell SmShell with compile-time hashed command table (SaliMShell)
+     v0.31 appended deferred binary logging smLog (SaliMLog)
+     v0.32 appended table-driven integer, hex, fixed-point and hexdump formatters smFormat... and smAppend... (SaliMUtils)
    */
 #ifndef SALIMCORE_H
 #define SALIMCORE_H
 
 
 #define SM_VERSION_MAJOR 0
-#define SM_VERSION_MINOR 7
+#define SM_VERSION_MINOR 32
 
 
 
@@ -75,6 +102,13 @@
 
 //#define __cplusplus
 
+#include <stdint.h>
+
+//Period of system tick in microseconds. It is used by 64-bit time functions
+#ifndef SM_TICK_US
+  #define SM_TICK_US 1000
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -108,6 +142,51 @@ extern volatile int smTickCount;
 void smInit( unsigned stackCellSize );
 
 
+//!
+//! \brief smTickIsr System tick handler. It may be called from system tick timer handler instead of smTickCount++.
+//!                  In addition to smTickCount increment it extends tick count to 64 bits and captures cycle counter,
+//!                  which are required for smTickCount64 and smTimeUs
+//!
+void smTickIsr( void );
+
+//!
+//! \brief smTickCount64 Returns 64-bit system tick count. It requires smTickIsr as tick handler
+//! \return              64-bit system tick count
+//!
+int64_t smTickCount64( void );
+
+//!
+//! \brief smTimeUs Returns 64-bit monotonic time in microseconds since start. It combines tick count with
+//!                 hardware cycle counter, so it has sub-tick resolution. It requires smTickIsr as tick handler
+//!                 and it may be safely called from tasks while tick interrupt fires
+//! \return         Time in microseconds
+//!
+int64_t smTimeUs( void );
+
+//!
+//! \brief smPortCycleInit Starts hardware cycle counter. It is implemented in platform-dependent part
+//!
+void smPortCycleInit( void );
+
+//!
+//! \brief smPortCycleCount Returns free-running 32-bit hardware cycle counter. It is implemented in platform-dependent part
+//! \return                 Cycle counter
+//!
+unsigned smPortCycleCount( void );
+
+//!
+//! \brief smPortIrqDisable Disables interrupts. It is implemented in platform-dependent part
+//! \return                 Previous interrupt state which must be passed to smPortIrqRestore
+//!
+unsigned smPortIrqDisable( void );
+
+//!
+//! \brief smPortIrqRestore Restores interrupt state saved by smPortIrqDisable. It is implemented in platform-dependent part
+//! \param state            Interrupt state returned by smPortIrqDisable
+//!
+void smPortIrqRestore( unsigned state );
+
+
 //! @}
 
 #ifdef __cplusplus
@@ -207,6 +286,50 @@ inline SmValue smWrap( SmValue minVal, SmValue val, SmValue maxVal )
 template <class SmValue>
 inline SmValue smUpperRound( SmValue val, SmValue bound ) { return smWrap( 0, val, bound); }
 
+
+
+//!
+//! \brief The SmLess struct Comparator which compares two values with operator <
+//!
+template <class SmValue>
+struct SmLess {
+    bool operator () ( const SmValue &v1, const SmValue &v2 ) const { return v1 < v2; }
+  };
+
+
+//!
+//! \brief The SmGreater struct Comparator which compares two values with operator >
+//!
+template <class SmValue>
+struct SmGreater {
+    bool operator () ( const SmValue &v1, const SmValue &v2 ) const { return v1 > v2; }
+  };
+
+
+//!
+//! \brief The SmHash struct Hash function for integer values. Value is multiplied by golden ratio constant and high
+//!                       bits are mixed to low bits, so sequential values are spread over table
+//!
+template <class SmValue>
+struct SmHash {
+    unsigned operator () ( const SmValue &v ) const { unsigned h = static_cast<unsigned>(v) * 2654435769u; return h ^ (h >> 16); }
+  };
+
+
+
+
+//!
+//! \brief The SmIrqLocker class Helper class for guard short code fragment against interrupts. Interrupts are disabled
+//!                           while object exists and restored to previous state when it leaves visibility zone
+//!
+class SmIrqLocker {
+    unsigned mState; //!< Interrupt state before locking
+  public:
+    SmIrqLocker() : mState(smPortIrqDisable()) {}
+
+    ~SmIrqLocker() { smPortIrqRestore( mState ); }
+  };
+
 //! @} helperFunctions
 
 
@@ -229,7 +352,7 @@ inline SmValue smUpperRound( SmValue val, SmValue bound ) { return smWrap( 0, va
 //! \return             Time moment in the future
 //!
 inline
-int  smTickFuture( int tickOut ) { return smTickCount + tickOut; }
+int  smTickFuture( int tickOut ) { return static_cast<int>( static_cast<unsigned>(smTickCount) + static_cast<unsigned>(tickOut) ); }
 
 
 //!
@@ -238,7 +361,25 @@ int  smTickFuture( int tickOut ) { return smTickCount + tickOut; }
 //! \return            true - when smTickCount rich futureTime moment
 //!
 inline
-bool smTickIsOut( int futureTick ) { return (smTickCount - futureTick) >= 0; }
+bool smTickIsOut( int futureTick ) { return static_cast<int>( static_cast<unsigned>(smTickCount) - static_cast<unsigned>(futureTick) ) >= 0; }
+
+
+//!
+//! \brief smTimeFutureUs Helper function for calculate moment in the future in microseconds. Is used for time out calculation.
+//! \param timeOutUs      Time in microseconds which added to current time to get future moment
+//! \return               Time moment in the future in microseconds
+//!
+inline
+int64_t smTimeFutureUs( int64_t timeOutUs ) { return smTimeUs() + timeOutUs; }
+
+
+//!
+//! \brief smTimeIsOutUs Helper function to detect when time out in microseconds. 64-bit time does not wrap
+//! \param futureUs      Moment in the future in microseconds. When time rich this moment function will return true
+//! \return              true - when time rich futureUs moment
+//!
+inline
+bool smTimeIsOutUs( int64_t futureUs ) { return smTimeUs() >= futureUs; }
 
 //! @} tickFunctions
 
@@ -250,89 +391,182 @@ bool smTickIsOut( int futureTick ) { return (smTickCount - futureTick) >= 0; }
 
 
 
-/*! \defgroup taskFunctions SaliMLib functions for task creation
+/*! \defgroup wakeHistogram SaliMLib Wake-latency histograms
     \ingroup CPlusPlusPart
-    \brief This functions used for task creation
+    \brief Per-task histograms of wake latency. Deadline histogram records how late task resumes after timed wait
+           relative to requested moment. Signal histogram records delay between event signal and task resume.
+           Signal moment is taken from SmEventFlags::set, for smWaitAndFuture family it is last smWaitSignal call.
+           Buckets are logarithmic: bucket 0 counts latencies below 1 us, bucket k counts latencies from 2^(k-1) us
+           to 2^k us, last bucket counts all longer latencies. Histograms are enabled by defining global macro
+           SM_WAKE_HISTOGRAM to 1, otherwise record functions are empty and cost nothing. Microsecond time requires
+           smTickIsr as tick handler. Histograms are kept in task blocks of native scheduler, so they are not
+           available with backends (defined SM_WAIT_SIGNAL).
     @{
-    */
+*/
+
+#ifndef SM_WAKE_HISTOGRAM
+  #define SM_WAKE_HISTOGRAM 0
+#endif
+
+#if SM_WAKE_HISTOGRAM && defined(SM_WAIT_SIGNAL)
+  #error "SM_WAKE_HISTOGRAM requires native scheduler: backends do not record wakeups in task blocks"
+#endif
+
+//Count of buckets in each histogram
+#ifndef SM_WAKE_HISTOGRAM_BUCKETS
+  #define SM_WAKE_HISTOGRAM_BUCKETS 16
+#endif
+
+//Histogram kinds
+#define SM_WAKE_DEADLINE 0 //!< Latency of resume after timed wait deadline
+#define SM_WAKE_SIGNAL   1 //!< Latency of resume after event signal
+#define SM_WAKE_KINDS    2
 
+#if SM_WAKE_HISTOGRAM
 //!
-//! \brief SmTaskFunction Task function prototype. It take one argument as pointer to void and return nothing.
+//! \brief smWakeRecordFuture Records latency of current task resume relative to tick moment
+//! \param future             Moment in ticks when task must be resumed
 //!
-using SmTaskFunction = void (*)(void *arg);
+void smWakeRecordFuture( int future );
 
+//!
+//! \brief smWakeRecordFutureUs Records latency of current task resume relative to moment in microseconds
+//! \param futureUs             Moment in microseconds when task must be resumed
+//!
+void smWakeRecordFutureUs( int64_t futureUs );
 
 //!
-//! \brief smTaskCreate  Creates new task with stackCellSize stack size and taskFunctor as task entry point
-//! \param stackCellSize Task stack size in 32-bit cell
-//! \param arg           Param for task, may any or nothing
-//! \param taskFunction  Task entry point function
-//! \param critic        Define priority level for task. All task devided into two sections: critic tasks and all other.
-//!                      Critic task handled as fast as possible and suit for polling tasks.
+//! \brief smWakeRecordSignal Records latency of current task resume relative to event signal moment
+//! \param signalUs           Moment in microseconds when event was signaled
 //!
-void smTaskCreate( unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic = false );
+void smWakeRecordSignal( int64_t signalUs );
 
+//!
+//! \brief smWakeSignalMark Stores moment of last smWaitSignal call. It is called by smWaitSignal, so it may be called from interrupt
+//!
+void smWakeSignalMark();
 
+//!
+//! \brief smWakeWaitBegin Returns moment when wait begins. It is passed to smWakeRecordWait after wait
+//! \return                Current time in microseconds
+//!
+inline int64_t smWakeWaitBegin() { return smTimeUs(); }
 
+//!
+//! \brief smWakeRecordWait Records latency of current task resume after wait with custom test function. Latency is
+//!                         counted in signal histogram from last smWaitSignal call if it was made after wait began,
+//!                         otherwise nothing is recorded because moment of event is unknown
+//! \param beginUs          Moment when wait began returned by smWakeWaitBegin
+//!
+void smWakeRecordWait( int64_t beginUs );
 
 //!
-//! \brief smTaskCreateClass Template for automatic conversion of task function argument. It simply converts class pointer cls to void
-//!                          for task creation argument and task entry function prototype
-//! \param stackCellSize     Task stack size in 32-bit cell
-//! \param cls               Class pointer param for task
-//! \param taskFunction      Task entry point function with Class pointer as argument
+//! \brief smWakeHistogram Returns count of wakeups in histogram bucket
+//! \param task            Task index in creation order. 0 is main loop task
+//! \param kind            Histogram kind: SM_WAKE_DEADLINE or SM_WAKE_SIGNAL
+//! \param bucket          Bucket index
+//! \return                Count of wakeups
 //!
-template <class SmClass>
-void smTaskCreateClass( unsigned stackCellSize, SmClass *cls, void (*taskFunction)( SmClass *cls ) )
-  {
-  smTaskCreate( stackCellSize, cls, (SmTaskFunction)(taskFunction) );
-  }
+unsigned smWakeHistogram( int task, int kind, int bucket );
 
-//! @} taskFunctions
+//!
+//! \brief smWakeHistogramClear Clears histograms of all tasks
+//!
+void smWakeHistogramClear();
+
+//!
+//! \brief smWakeHistogramDump Dumps not empty histograms of all tasks as text. Each line has task index, histogram kind
+//!                            and pairs of bucket lower bound in microseconds and count, for example:
+//!                            "task 1 deadline 0:120 1:14 8:1"
+//! \param putChar             Function which outputs one char, for example to UART
+//!
+void smWakeHistogramDump( void (*putChar)( char ch ) );
+#else
+inline void smWakeRecordFuture( int ) {}
+inline void smWakeRecordFutureUs( int64_t ) {}
+inline void smWakeRecordSignal( int64_t ) {}
+inline void smWakeSignalMark() {}
+inline int64_t smWakeWaitBegin() { return 0; }
+inline void smWakeRecordWait( int64_t ) {}
+#endif
 
+//! @} wakeHistogram
 
 
 
 
 
 
-/*! \defgroup waitFunctions SaliMLib functions for event waiting
+
+
+
+/*! \defgroup hogDetector SaliMLib Hog detector
     \ingroup CPlusPlusPart
+    \brief Cooperative task holds processor until it calls any wait function. Hog detector measures each run slice
+           of task, i.e. time from task resume to next call of wait function, holds longest slice of each task
+           and calls callback function when slice exceeds budget. Detector is enabled by defining global macro
+           SM_HOG_DETECTOR to 1. Microsecond time requires smTickIsr as tick handler. Run slices are measured by
+           task switch of native scheduler, so detector is not available with backends (defined SM_WAIT_SIGNAL).
     @{
+*/
 
-    */
+#ifndef SM_HOG_DETECTOR
+  #define SM_HOG_DETECTOR 0
+#endif
 
+#if SM_HOG_DETECTOR && defined(SM_WAIT_SIGNAL)
+  #error "SM_HOG_DETECTOR requires native scheduler: backends do not measure run slices at task switch"
+#endif
 
+#if SM_HOG_DETECTOR
+//!
+//! \brief SmHogFunction Hog callback prototype. It is called from task which exceeds budget, just before task switch.
+//!                      It take task index in creation order (0 is main loop task) and length of slice in microseconds
+//!
+using SmHogFunction = void (*)( int task, unsigned sliceUs );
 
 //!
-//! \brief The SmPair template struct used to transfer pair of any values to wait function in smWait<> template
+//! \brief smHogBudget Sets budget of run slice and callback which called when any task exceeds budget
+//! \param budgetUs    Budget of run slice in microseconds
+//! \param fun         Callback function or nullptr to disable callback
 //!
-template <typename SmValue1, typename SmValue2>
-struct SmPair {
-    SmValue1 mValue1; //!< First value
-    SmValue2 mValue2; //!< Second value
+void smHogBudget( unsigned budgetUs, SmHogFunction fun );
 
-    SmPair( SmValue1 val1, SmValue2 val2 ) : mValue1(val1), mValue2(val2) {}
-  };
+//!
+//! \brief smHogMaxSlice Returns longest run slice of task
+//! \param task          Task index in creation order. 0 is main loop task
+//! \return              Longest run slice in microseconds
+//!
+unsigned smHogMaxSlice( int task );
+
+//!
+//! \brief smHogClear Clears longest run slices of all tasks
+//!
+void smHogClear();
+#endif
+
+//! @} hogDetector
 
 
 
 
-//!
-//! \brief The SmTrio template struct used to transfer trio of any values to wait function in smWait<> template
-//!
-template <typename SmValue1, typename SmValue2, typename SmValue3>
-struct SmTrio {
-    SmValue1 mValue1; //!< First value
-    SmValue2 mValue2; //!< Second value
-    SmValue3 mValue3; //!< Third value
 
-    SmTrio( SmValue1 val1, SmValue2 val2, SmValue3 val3 ) : mValue1(val1), mValue2(val2), mValue3(val3) {}
-  };
 
 
 
 
+/*! \defgroup taskFunctions SaliMLib functions for task creation
+    \ingroup CPlusPlusPart
+    \brief This functions used for task creation
+    @{
+    */
+
+//!
+//! \brief SmTaskFunction Task function prototype. It take one argument as pointer to void and return nothing.
+//!
+using SmTaskFunction = void (*)(void *arg);
+
+
 //!
 //! \brief SmWaitFunction Wait function prototype. It take one argument as pointer to void and return bool as result.
 //!                       If it return true then task resumed
@@ -340,659 +574,2644 @@ struct SmTrio {
 using SmWaitFunction = bool (*)(void *arg);
 
 
+//Earliest-deadline-first scheduling of critic tasks. When enabled, from all ready critic tasks scheduler selects
+//task with earliest deadline instead of first one in task ring order
+#ifndef SM_EDF
+  #define SM_EDF 0
+#endif
+
+//Relative deadline of tasks which do not declare deadline. Such task is later than any task with deadline
+#define SM_EDF_NO_DEADLINE 0x3fffffff
+
+//!
+//! \brief The SmTaskBlock struct Task control block. Blocks of tasks created with smTaskCreate are taken from internal
+//!                          pool of SM_TASK_MAX blocks. Block may be provided by caller, for example as member of object
+//!                          which owns task. Then count of tasks is not limited and memory is spent only for existing tasks.
+//!                          Caller-provided block must live while task exists. When task function returns, block
+//!                          becomes free and may be used for new task, its stack is reused when it is large enough
+//!
+struct SmTaskBlock {
+    unsigned       mTopOfStack;    //!< Saved stack pointer of task. It must be first member, because port accesses it
+    unsigned       mStackCellSize; //!< Size of task stack in 32-bit cells or 0 when stack is not allocated
+    SmTaskBlock   *mNextTask;      //!< Next task in task ring
+    SmTaskBlock   *mPrevTask;      //!< Previous task in task ring
+    void          *mArg;           //!< Argument of task function or argument of wait function while task waits
+    SmWaitFunction mWaitFunction;  //!< Wait function of task
+    SmTaskFunction mTaskFunction;  //!< Task entry point function or nullptr when block is free
+    unsigned       mStackTop;      //!< Top of allocated task stack
+    int            mId;            //!< Task index in creation order. 0 is main loop task
+    bool           mCritic;        //!< Critic task flag
+    bool           mSuspended;     //!< True when task is suspended and excluded from task ring
+    SmTaskBlock   *mNextSuspended; //!< Next task in list of suspended tasks
+#if SM_EDF
+    bool           mDeadlineSet;   //!< True when absolute deadline of next wait set by smTaskSetDeadlineAt
+    bool           mDeadlineOpen;  //!< True while task waits and is not yet found ready, so mDeadline is not stamped
+    int            mDeadline;      //!< Absolute deadline in ticks of current wait
+    int            mRelDeadline;   //!< Relative deadline in ticks counted from moment when task is found ready
+#endif
+#if SM_WAKE_HISTOGRAM
+    unsigned       mWakeHistogram[SM_WAKE_KINDS][SM_WAKE_HISTOGRAM_BUCKETS]; //!< Wake-latency histograms
+#endif
+#if SM_HOG_DETECTOR
+    unsigned       mSliceStart;    //!< Low 32 bits of time in microseconds when task resumed
+    unsigned       mMaxSlice;      //!< Longest run slice in microseconds
+#endif
+
+    //Constructor is inline, so caller-provided blocks may be used with backends which do not build SaliMCore.cpp
+    SmTaskBlock() :
+      mTopOfStack(0),
+      mStackCellSize(0),
+      mNextTask(nullptr),
+      mPrevTask(nullptr),
+      mArg(nullptr),
+      mWaitFunction(nullptr),
+      mTaskFunction(nullptr),
+      mStackTop(0),
+      mId(0),
+      mCritic(false),
+      mSuspended(false),
+      mNextSuspended(nullptr)
+#if SM_EDF
+      ,mDeadlineSet(false),
+      mDeadlineOpen(false),
+      mDeadline(0),
+      mRelDeadline(SM_EDF_NO_DEADLINE)
+#endif
+      {
+#if SM_WAKE_HISTOGRAM
+      clearWakeHistogram();
+#endif
+#if SM_HOG_DETECTOR
+      mSliceStart = mMaxSlice = 0;
+#endif
+      }
+
+    //!
+    //! \brief isFree Check if block is not used by any task
+    //! \return       true when block is free
+    //!
+    bool isFree() const { return mTaskFunction == nullptr; }
+
+    //!
+    //! \brief linkAfter Includes task to task ring after specified task
+    //! \param task      Task in task ring
+    //!
+    void linkAfter( SmTaskBlock *task ) { mPrevTask = task; mNextTask = task->mNextTask; mNextTask->mPrevTask = this; task->mNextTask = this; }
+
+    //!
+    //! \brief unlink Excludes task from task ring. mNextTask remains valid, so scan of ring may start from it
+    //!
+    void unlink() { mPrevTask->mNextTask = mNextTask; mNextTask->mPrevTask = mPrevTask; }
+
+    void buildTask( unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic );
+
+    void buildTask( unsigned *stack, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic );
+
+    void startTask( void *arg, SmTaskFunction taskFunction, bool critic );
+
+#if SM_WAKE_HISTOGRAM
+    void clearWakeHistogram() {
+      for( int kind = 0; kind < SM_WAKE_KINDS; kind++ )
+        for( int bucket = 0; bucket < SM_WAKE_HISTOGRAM_BUCKETS; bucket++ )
+          mWakeHistogram[kind][bucket] = 0;
+      }
+
+    void wakeRecord( int kind, int64_t latencyUs );
+#endif
+
+#if SM_HOG_DETECTOR
+    void sliceBegin() { mSliceStart = static_cast<unsigned>( smTimeUs() ); }
+
+    void sliceEnd();
+#endif
+
+    static bool criticUsed;
+  };
+
+
 //!
-//! \brief smWaitVoid   Main wait function. Wait while waitFuncion return true. While task is in wait state cpu switch to other tasks
-//! \param arg          Any argument for waitFuncion
-//! \param waitFunction Pointer to wait function
+//! \brief SmTaskHandle Handle of task. It is used to address task after creation
 //!
-void smWaitVoid( void *arg, SmWaitFunction waitFunction );
+using SmTaskHandle = SmTaskBlock*;
 
 
 //!
-//! \brief smWait       Template for automatic conversion of waitFunction argument. It simply converts specified pointer to void
-//!                     for smWait and waitFunction
-//! \param arg          WaitFunction argument
-//! \param waitFunction Pointer to wait function
+//! \brief smTaskCreate  Creates new task with stackCellSize stack size and taskFunctor as task entry point
+//! \param stackCellSize Task stack size in 32-bit cell
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Define priority level for task. All task devided into two sections: critic tasks and all other.
+//!                      Critic task handled as fast as possible and suit for polling tasks.
+//! \return              Handle of created task or nullptr when there is no free task block
 //!
-template <class SmArg>
-void smWait( SmArg *arg, bool (*waitFunction)( SmArg *farg ) )
-  {
-  smWaitVoid( arg, (SmWaitFunction)(waitFunction) );
-  }
+SmTaskHandle smTaskCreate( unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic = false );
 
 
-template <class SmArg>
-void smWaitRef( SmArg &arg, bool (*waitFunction)( SmArg *farg ) )
-  {
-  smWaitVoid( &arg, (SmWaitFunction)(waitFunction) );
-  }
+//!
+//! \brief smTaskCreate  Creates new task in caller-provided task block
+//! \param block         Task block. It must be free and must live while task exists
+//! \param stackCellSize Task stack size in 32-bit cell
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Define priority level for task
+//! \return              Handle of created task or nullptr when block is not free
+//!
+SmTaskHandle smTaskCreate( SmTaskBlock *block, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic = false );
+
 
 
 
 //!
-//! \brief smWaitClass Template for automatic using class operator() member-function for stop wait event.
-//!                    smClass must have member-function with prototype "bool operator () () { ... }".
-//!                    When this function return true waiting stop and task resumed.
-//! \param cls         Any class object which has member-function operator().
+//! \brief The SmTaskStack struct Caller-provided task stack with stackCellSize 32-bit cells. It is aligned to 8 bytes as
+//!                          required by ARM procedure call standard. Stack may be placed to any memory section,
+//!                          for example to core-coupled memory:
+//!                          static SmTaskStack<200> fastStack __attribute__((section(".ccmram")));
 //!
-template <class SmClass>
-void smWaitClass( SmClass cls )
-  {
-  smWait<SmClass>( &cls, [] ( SmClass *ptr ) -> bool { return ptr(); } );
-  }
+template <unsigned stackCellSize>
+struct SmTaskStack {
+    alignas(8) unsigned mStack[stackCellSize]; //!< Stack memory
 
+    //!
+    //! \brief cellSize Returns size of stack in 32-bit cells
+    //! \return         Size of stack in 32-bit cells
+    //!
+    static constexpr unsigned cellSize() { return stackCellSize; }
+  };
 
-//!
-//! \brief smWaitClassPtr Template for automatic using class operator() member-function for stop wait event.
-//!                       SmClass must have member-function with prototype "bool operator () () { ... }".
-//!                       When this function return true waiting stop and task resumed.
-//! \param cls            Any class object which has member-function operator().
-//!
-template <class SmClass>
-void smWaitClassPtr( SmClass *cls )
-  {
-  smWait<SmClass>( cls, [] ( SmClass *ptr ) -> bool { return (*ptr)(); } );
-  }
 
 
 
 //!
-//! \brief smWaitBoolTrue Helper function which wait until bool is set to true
-//! \param arg            Testing bool
+//! \brief smTaskCreate  Creates new task in caller-provided task block with caller-provided stack. Stack is not taken from
+//!                      main stack, so main stack size does not depend on this task
+//! \param block         Task block. It must be free and must live while task exists
+//! \param stack         Task stack memory. It must live while task exists
+//! \param stackCellSize Task stack size in 32-bit cell
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Define priority level for task
+//! \return              Handle of created task or nullptr when block is not free
 //!
-inline void smWaitBoolTrue( bool *arg )
-  {
-  smWait<bool>( arg, [] ( bool *arg ) -> bool { return *arg; } );
-  }
+SmTaskHandle smTaskCreate( SmTaskBlock *block, unsigned *stack, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic = false );
+
 
 
 
 //!
-//! \brief smWaitBoolFalse Helper function which wait until bool is set to false
-//! \param arg             Testing bool
+//! \brief smTaskCreate Creates new task in caller-provided task block with caller-provided stack sized by template
+//! \param block        Task block. It must be free and must live while task exists
+//! \param stack        Task stack. It must live while task exists
+//! \param arg          Param for task, may any or nothing
+//! \param taskFunction Task entry point function
+//! \param critic       Define priority level for task
+//! \return             Handle of created task or nullptr when block is not free
 //!
-inline void smWaitBoolFalse( bool *arg )
+template <unsigned stackCellSize>
+SmTaskHandle smTaskCreate( SmTaskBlock *block, SmTaskStack<stackCellSize> &stack, void *arg, SmTaskFunction taskFunction, bool critic = false )
   {
-  smWait<bool>( arg, [] ( bool *arg ) -> bool { return !*arg; } );
+  return smTaskCreate( block, stack.mStack, stackCellSize, arg, taskFunction, critic );
   }
 
 
+
+
+#if SM_EDF
 //!
-//! \brief smWaitIntUntilZero Helper function which wait until int is set to 0
-//! \param arg                Testing int
+//! \brief smTaskSetDeadline Sets relative deadline of current task. On each wait absolute deadline of task is
+//!                          moment when scheduler first finds task ready plus relative deadline, so task which
+//!                          waited long for event is not more urgent than task which became ready at the same
+//!                          moment. It is used when SM_EDF is enabled and only for critic tasks
+//! \param tickOut           Relative deadline in ticks or SM_EDF_NO_DEADLINE
 //!
-inline void smWaitIntUntilZero( int *arg )
-  {
-  smWait<int>( arg, [] ( int *arg ) -> bool { return *arg == 0; } );
-  }
-
+void smTaskSetDeadline( int tickOut );
 
 //!
-//! \brief smWaitIntUntilNotZero Helper function which wait until int is set to not 0
-//! \param arg                   Tesming int
+//! \brief smTaskSetDeadlineAt Sets absolute deadline of current task for next wait only. Next waits return to
+//!                            relative deadline
+//! \param future              Absolute deadline. This value returned by function smTickFuture
 //!
-inline void smWaitIntUntilNotZero( int *arg )
-  {
-  smWait<int>( arg, [] ( int *arg ) -> bool { return *arg != 0; } );
-  }
+void smTaskSetDeadlineAt( int future );
+#endif
 
 
+
+
+//Periodic tasks and operations with task handles work on task ring of native scheduler, so they are not available
+//with backends (defined SM_WAIT_SIGNAL)
+#ifndef SM_WAIT_SIGNAL
+
 //!
-//! \brief smWaitAndFuture Helper function which wait until fun return true or future will come
-//! \param future          Future value. This value returned by function smTickFuture
-//! \param fun             Function to test. When this function returns true smWaitAndFuture will return true
-//! \return                true when fun return true or false when future will come
+//! \brief The SmTaskPeriodic class Periodic task. Its job function is called once per period. Releases are locked to
+//!                            absolute ticks, so period does not drift by job execution time. All periodic tasks are
+//!                            released by scheduler from one list sorted by release moment, so waiting periodic tasks
+//!                            cost one comparison per task switch in total. Object must live while task exists
 //!
-inline bool smWaitAndFuture( int future, bool (*fun) () )
-  {
-  //Internal structure to hold pair future value and test function
-  struct SmWaitAndTime
-    {
-      int  mFuture;   //Future value
-      bool (*mFun)(); //Test function
-    } w;
-
-  //Fill structure with params
-  w.mFuture = future;
-  w.mFun    = fun;
+class SmTaskPeriodic {
+    SmTaskBlock     mBlock;       //!< Task block
+    SmTaskPeriodic *mNextRelease; //!< Next task in release list
+    SmTaskFunction  mJob;         //!< Job function
+    void           *mArg;         //!< Argument of job function
+    int             mPeriod;      //!< Period in ticks
+    int             mRelease;     //!< Moment of next release
+    volatile bool   mReleased;    //!< True when task released
+    unsigned        mJobs;        //!< Count of completed jobs
+    unsigned        mOverruns;    //!< Count of jobs completed after next release moment
+    unsigned        mJitterMin;   //!< Minimal delay of job start after release in microseconds
+    unsigned        mJitterMax;   //!< Maximal delay of job start after release in microseconds
+    uint64_t        mJitterSum;   //!< Sum of delays of job start after release in microseconds
+  public:
+    SmTaskPeriodic();
 
-  //Call wait function
-  smWait<SmWaitAndTime>( &w, [] (SmWaitAndTime *w) ->bool { return smTickIsOut(w->mFuture) || w->mFun(); } );
+    //!
+    //! \brief jobCount Returns count of completed jobs
+    //! \return         Count of completed jobs
+    //!
+    unsigned jobCount() const { return mJobs; }
 
-  //Return result
-  return !smTickIsOut(future);
-  }
+    //!
+    //! \brief overrunCount Returns count of overruns, i.e. jobs which completed after next release moment
+    //! \return             Count of overruns
+    //!
+    unsigned overrunCount() const { return mOverruns; }
 
+    //!
+    //! \brief jitterMin Returns minimal delay of job start after release
+    //! \return          Minimal delay in microseconds
+    //!
+    unsigned jitterMin() const { return mJobs ? mJitterMin : 0; }
 
+    //!
+    //! \brief jitterMax Returns maximal delay of job start after release
+    //! \return          Maximal delay in microseconds
+    //!
+    unsigned jitterMax() const { return mJitterMax; }
 
-//!
-//! \brief smWaitAndFuture Helper function which wait until fun return true or tickOut elapsed
-//! \param tickOut         TickOut value
-//! \param fun             Function to test. When this function returns true smWaitAndFuture will return true
-//! \return                true when fun return true or false when tickOut elapsed
-//!
-inline bool smWaitAndTick( int tickOut, bool (*fun)() )
-  {
-  return smWaitAndFuture( smTickFuture(tickOut), fun );
-  }
+    //!
+    //! \brief jitterAverage Returns average delay of job start after release
+    //! \return              Average delay in microseconds
+    //!
+    unsigned jitterAverage() const { return mJobs ? static_cast<unsigned>( mJitterSum / mJobs ) : 0; }
 
+    //!
+    //! \brief clearStatistics Clears counters and jitter statistics
+    //!
+    void     clearStatistics();
 
+  private:
+    void        link();
 
-//!
-//! \brief smWaitAndFutureArg1 Template function which work same as smWaitAndFuture but test function accept one argument
-//! \param future              Future value. This value returned by function smTickFuture
-//! \param arg1                Argument for test function
-//! \param fun                 Function to test. When this function returns true smWaitAndFuture will return true
-//! \return                    true when fun return true or false when future will come
-//!
-template<class SmArg1>
-inline bool smWaitAndFutureArg1( int future, SmArg1 arg1, bool (*fun)( SmArg1 ) )
-  {
-  //Internal structure to hold association future value, test function and argument for test function
-  struct SmWaitAndTime
-    {
-      int     mFuture;            //Future value
-      SmArg1  mArg1;              //Argument for test function
-      bool    (*mFun)( SmArg1 );  //Test function with arg
-    } w;
+    static void taskEntry( void *arg );
 
-  //Fill structure with params
-  w.mFuture = future;
-  w.mArg1   = arg1;
-  w.mFun    = fun;
+    static void unlink( SmTaskHandle task );
 
-  //Call wait function
-  smWait<SmWaitAndTime>( &w, [] (SmWaitAndTime *w) ->bool { return smTickIsOut(w->mFuture) || w->mFun( w->mArg1 ); } );
+    friend SmTaskHandle smTaskCreatePeriodic( SmTaskPeriodic *periodic, unsigned stackCellSize, int period, int phase, SmTaskFunction job, void *arg, bool critic );
+    friend void smTaskPeriodicRelease();
+    friend void smTaskTerminate( SmTaskHandle task );
+  };
 
-  //Return result
-  return !smTickIsOut(future);
-  }
 
 
 
 //!
-//! \brief smWaitAndTickArg1 Helper function which wait until fun return true or tickOut elapsed
-//! \param tickOut           TickOut value
-//! \param arg1              Argument for test function
-//! \param fun               Function to test. When this function returns true smWaitAndFuture will return true
-//! \return                  true when fun return true or false when tickOut elapsed
+//! \brief smTaskCreatePeriodic Creates periodic task. First job is released after phase ticks, next jobs are released
+//!                             every period ticks after first one. When job completes after next release moment,
+//!                             overrun is counted and next job starts immediately, releases missed completely are skipped.
+//!                             Job completed exactly at next release tick is not overrun.
+//!                             With SM_EDF deadline of job is its next release moment
+//! \param periodic             Periodic task object
+//! \param stackCellSize        Task stack size in 32-bit cell
+//! \param period               Period in ticks. It must be positive
+//! \param phase                Delay of first release in ticks
+//! \param job                  Job function. It is called once per period and must return
+//! \param arg                  Argument for job function, may any or nothing
+//! \param critic               Define priority level for task
+//! \return                     Handle of created task or nullptr when period is not positive or task of periodic object
+//!                             still exists
 //!
-template<class SmArg1>
-inline bool smWaitAndTickArg1( int tickOut, SmArg1 arg1, bool (*fun)( SmArg1 ) )
-  {
-  return smWaitAndFutureArg1<SmArg1>( smTickFuture(tickOut), arg1, fun );
-  }
+SmTaskHandle smTaskCreatePeriodic( SmTaskPeriodic *periodic, unsigned stackCellSize, int period, int phase, SmTaskFunction job, void *arg = nullptr, bool critic = false );
+
 
 
 
 //!
-//! \brief smWaitTick Helper function for waiting specified timeOut. It resume this task after timeOut elapsed
-//! \param timeOut    Waiting time out
+//! \brief smTaskPeriodicRelease Releases periodic tasks which release moment is come. It is called by scheduler on each task switch
 //!
-void smWaitTick( int timeOut );
+void smTaskPeriodicRelease();
+
+
 
 
 //!
-//! \brief smWaitTickUntilHard Helper function for waiting specified moment in the future. When waiting this function do nothing, so it not used multitasking
-//! \param futureTime          Moment in the future
+//! \brief smTaskCurrent Returns handle of current task
+//! \return              Handle of current task
 //!
-inline void smWaitTickUntilHard( int futureTime )
-  {
-  while( !smTickIsOut(futureTime) );
-  }
+SmTaskHandle smTaskCurrent();
+
 
 
 
 //!
-//! \brief smWaitTickHard Helper function for waiting specified timeOut. When waiting this function do nothing, so it not used multitasking
-//! \param timeOut        Waiting time out
+//! \brief smTaskFirst Returns first task for enumeration of all existing tasks. It is main loop task
+//! \return            Handle of main loop task
 //!
-inline void smWaitTickHard( int timeOut )
-  {
-  smWaitTickUntilHard( smTickFuture(timeOut) );
-  }
+SmTaskHandle smTaskFirst();
+
+
 
 
 //!
-//! \brief smWaitTickUntil Helper function for waiting specified moment in the future. It resume this task after system tick count reach this moment
-//! \param futureTime      Moment in the future
+//! \brief smTaskNext Returns next task for enumeration of all existing tasks: tasks of task ring beginning from
+//!                   main loop task, then suspended tasks, which are not in task ring
+//! \param task       Handle of current task of enumeration
+//! \return           Handle of next task or nullptr when task is last one
 //!
-inline void smWaitTickUntil( int futureTime )
-  {
-  //Wait this moment
-  smWait<int>( &futureTime, [] ( int *timeOutArg ) -> bool { return smTickIsOut( *timeOutArg ); } );
-  }
+SmTaskHandle smTaskNext( SmTaskHandle task );
+
+
 
 
 //!
-//! \brief smYeld Simple funtion which switch to another task and resume this task when task loop round
+//! \brief smTaskSuspend Suspends task. Suspended task is excluded from task ring, so it costs no scheduler time.
+//!                      When task suspends itself, it switches to other task and returns after resume.
+//!                      Main loop task can not be suspended. Suspended task is not visited by walk of task
+//!                      ring, use smTaskFirst and smTaskNext to enumerate all tasks including suspended ones
+//! \param task          Handle of task
 //!
-void smYeld();
+void smTaskSuspend( SmTaskHandle task );
+
 
-//! @} waitFunctions
 
 
+//!
+//! \brief smTaskResume Resumes suspended task. Task is included to task ring after current task and continues
+//!                     its wait
+//! \param task         Handle of task
+//!
+void smTaskResume( SmTaskHandle task );
 
 
 
 
+//!
+//! \brief smTaskIsSuspended Check if task is suspended
+//! \param task              Handle of task
+//! \return                  true when task is suspended
+//!
+inline bool smTaskIsSuspended( SmTaskHandle task ) { return task->mSuspended; }
 
 
-/*! \defgroup mutex SaliMLib Mutex
-    \ingroup CPlusPlusPart
-    @{
 
-    */
 
 //!
-//! \brief The SmMutex class Helper class for guard some resource against sharing
+//! \brief smTaskTerminate Terminates task. Task is excluded from task ring and release list of periodic tasks and its block becomes free. Resources
+//!                        held by task, for example locked mutexes, are not released. When task terminates itself,
+//!                        this function does not return. Main loop task can not be terminated
+//! \param task            Handle of task
 //!
-class SmMutex {
-    bool mBusy; //!< Variable to indicate resource is busy
-  public:
-    //!
-    //! \brief SmMutex Construct initialy not busy resource
-    //!
-    SmMutex() : mBusy(false) {}
-
-    //!
-    //! \brief isLocked Check if resource is busy
-    //! \return         true when resource is busy
-    //!
-    bool isLocked() const { return mBusy; }
+void smTaskTerminate( SmTaskHandle task );
 
-    //!
-    //! \brief lock Try lock resource. If resource is busy then it wait until it will be free.
-    //!             If resource is free it locked
-    //!
-    void lock() {
-      if( mBusy )
-        smWaitBoolFalse( &mBusy );
-      mBusy = true;
-      }
+#endif
 
-    //!
-    //! \brief unlock Unlocks resource
-    //!
-    void unlock() { mBusy = false; }
-  };
 
 
 
 //!
-//! \brief The SmMutexLocker class Helper class for automatic lock and unlock resource by using SmMutex
+//! \brief smTaskCreateClass Template for automatic conversion of task function argument. It simply converts class pointer cls to void
+//!                          for task creation argument and task entry function prototype
+//! \param stackCellSize     Task stack size in 32-bit cell
+//! \param cls               Class pointer param for task
+//! \param taskFunction      Task entry point function with Class pointer as argument
+//! \return                  Handle of created task or nullptr when there is no free task block
 //!
-class SmMutexLocker {
-    SmMutex &mMutex; //!< Mutex which guarding resource
-  public:
-    //!
-    //! \brief SmMutexLocker Constructor. It get mutex and try lock it. If resource is busy then it wait until it free
-    //! \param mutex         Mutex which guarding resource
-    //!
-    SmMutexLocker( SmMutex &mutex ) : mMutex(mutex) { mMutex.lock(); }
+template <class SmClass>
+SmTaskHandle smTaskCreateClass( unsigned stackCellSize, SmClass *cls, void (*taskFunction)( SmClass *cls ) )
+  {
+  return smTaskCreate( stackCellSize, cls, (SmTaskFunction)(taskFunction) );
+  }
 
-    //!
-    //! \brief ~SmMutexLocker Destructor automaticly unlock mutex when leave visibility zone
-    //!
-    ~SmMutexLocker() { mMutex.unlock(); }
-  };
+//! @} taskFunctions
 
-//! @} mutex
 
 
 
 
 
 
-/*! \defgroup semaphor SaliMLib Semaphor
+/*! \defgroup waitFunctions SaliMLib functions for event waiting
     \ingroup CPlusPlusPart
     @{
 
     */
 
-//!
-//! \brief The SmSemaphor class Helper class for guard some resource against multiple sharing
-//!
-class SmSemaphor {
-    int mCount; //!< Variable for indicate resource is busy. Resource is busy when mCount reaches 0. If mCount greater 0 then resource is free.
-  public:
-    SmSemaphor( int cnt ) : mCount(cnt) {}
 
-    //!
-    //! \brief isLocked Check if resource is busy
-    //! \return         true when resource is busy
-    //!
-    bool isLocked() const { return mCount == 0; }
 
-    //!
-    //! \brief lock Try lock resource. If resource is busy then it wait until it will be free.
-    //!             If resource is free it locked
-    //!
-    void lock() {
-      if( mCount == 0 )
-        smWaitIntUntilNotZero( &mCount );
-      mCount--;
-      }
+//!
+//! \brief The SmPair template struct used to transfer pair of any values to wait function in smWait<> template
+//!
+template <typename SmValue1, typename SmValue2>
+struct SmPair {
+    SmValue1 mValue1; //!< First value
+    SmValue2 mValue2; //!< Second value
 
-    //!
-    //! \brief unlock Unlocks resource
-    //!
-    void unlock() { mCount++; }
+    SmPair( SmValue1 val1, SmValue2 val2 ) : mValue1(val1), mValue2(val2) {}
   };
 
 
 
+
 //!
-//! \brief The SmSemaphorLocker class Helper class for automatic lock and unlock resource by using SmSemaphor
+//! \brief The SmTrio template struct used to transfer trio of any values to wait function in smWait<> template
 //!
-class SmSemaphorLocker {
-    SmSemaphor &mSemaphor; //!< Semaphor which guarding resource
-  public:
-    //!
-    //! \brief SmSemaphorLocker Constructor. It get semaphor and try lock it. If resource is busy then it wait until it free
-    //! \param sema             Semaphor which guarding resource
-    //!
-    SmSemaphorLocker( SmSemaphor &sema ) : mSemaphor(sema) { mSemaphor.lock(); }
+template <typename SmValue1, typename SmValue2, typename SmValue3>
+struct SmTrio {
+    SmValue1 mValue1; //!< First value
+    SmValue2 mValue2; //!< Second value
+    SmValue3 mValue3; //!< Third value
 
-    //!
-    //! \brief ~SmSemaphorLocker Destructor automaticly unlock semaphor when leave visibility zone
-    //!
-    ~SmSemaphorLocker() { mSemaphor.unlock(); }
+    SmTrio( SmValue1 val1, SmValue2 val2, SmValue3 val3 ) : mValue1(val1), mValue2(val2), mValue3(val3) {}
   };
 
-//! @} semaphor
 
 
 
 
 
+//!
+//! \brief smWaitVoid   Main wait function. Wait while waitFuncion return true. While task is in wait state cpu switch to other tasks
+//! \param arg          Any argument for waitFuncion
+//! \param waitFunction Pointer to wait function
+//!
+void smWaitVoid( void *arg, SmWaitFunction waitFunction );
 
 
+//!
+//! \brief smWaitVoidUntil Wait function with deadline. It works as smWaitVoid, but waitFunction must return true not later
+//!                        than future comes. Native scheduler tests wait functions on every task switch, so deadline is not
+//!                        used. Backends where waiting task blocks (defined SM_WAIT_SIGNAL) block until future instead of
+//!                        poll period, so timed waits do not wake task on every tick
+//! \param arg             Any argument for waitFuncion
+//! \param waitFunction    Pointer to wait function
+//! \param future          Deadline. This value returned by function smTickFuture
+//!
+#ifdef SM_WAIT_SIGNAL
+void smWaitVoidUntil( void *arg, SmWaitFunction waitFunction, int future );
+#else
+inline void smWaitVoidUntil( void *arg, SmWaitFunction waitFunction, int ) { smWaitVoid( arg, waitFunction ); }
+#endif
 
 
-/*! \defgroup fixedContainers SaliMLib Containers with fixed size
-    \ingroup CPlusPlusPart
-    @{
+//!
+//! \brief smWaitSignal Notifies waiting tasks that state of any primitive is changed, so their wait functions must be
+//!                     tested again. Native scheduler tests wait functions on every task switch, so here it does
+//!                     nothing. Backends where waiting task blocks (defined SM_WAIT_SIGNAL) wake waiting tasks.
+//!                     Library primitives call it on each state change, user code must call it after changing
+//!                     variables which tested by custom wait functions. It may be called from interrupt
+//!
+#ifdef SM_WAIT_SIGNAL
+void smWaitSignal();
+#else
+inline void smWaitSignal() { smWakeSignalMark(); }
+#endif
+
+
+//!
+//! \brief smWait       Template for automatic conversion of waitFunction argument. It simply converts specified pointer to void
+//!                     for smWait and waitFunction
+//! \param arg          WaitFunction argument
+//! \param waitFunction Pointer to wait function
+//!
+template <class SmArg>
+void smWait( SmArg *arg, bool (*waitFunction)( SmArg *farg ) )
+  {
+  smWaitVoid( arg, (SmWaitFunction)(waitFunction) );
+  }
+
+
+template <class SmArg>
+void smWaitRef( SmArg &arg, bool (*waitFunction)( SmArg *farg ) )
+  {
+  smWaitVoid( &arg, (SmWaitFunction)(waitFunction) );
+  }
+
+
+
+//!
+//! \brief smWaitUntil  Template for automatic conversion of waitFunction argument for smWaitVoidUntil
+//! \param arg          WaitFunction argument
+//! \param waitFunction Pointer to wait function. It must return true not later than future comes
+//! \param future       Deadline. This value returned by function smTickFuture
+//!
+template <class SmArg>
+void smWaitUntil( SmArg *arg, bool (*waitFunction)( SmArg *farg ), int future )
+  {
+  smWaitVoidUntil( arg, (SmWaitFunction)(waitFunction), future );
+  }
+
+
+
+//!
+//! \brief smWaitUntilUs Template same as smWaitUntil but deadline is in microseconds
+//! \param arg           WaitFunction argument
+//! \param waitFunction  Pointer to wait function. It must return true not later than futureUs comes
+//! \param futureUs      Deadline in microseconds. This value returned by function smTimeFutureUs
+//!
+template <class SmArg>
+void smWaitUntilUs( SmArg *arg, bool (*waitFunction)( SmArg *farg ), int64_t futureUs )
+  {
+#ifdef SM_WAIT_SIGNAL
+  //Deadline is rounded up to whole ticks, so blocked task is not resumed before futureUs
+  int64_t restUs = futureUs - smTimeUs();
+  int64_t rest   = restUs <= 0 ? 0 : (restUs + SM_TICK_US - 1) / SM_TICK_US;
+  smWaitVoidUntil( arg, (SmWaitFunction)(waitFunction), smTickFuture( rest > 0x3fffffff ? 0x3fffffff : static_cast<int>(rest) ) );
+#else
+  (void)futureUs;
+  smWaitVoid( arg, (SmWaitFunction)(waitFunction) );
+#endif
+  }
+
+
+
+//!
+//! \brief smWaitClass Template for automatic using class operator() member-function for stop wait event.
+//!                    smClass must have member-function with prototype "bool operator () () { ... }".
+//!                    When this function return true waiting stop and task resumed.
+//! \param cls         Any class object which has member-function operator().
+//!
+template <class SmClass>
+void smWaitClass( SmClass cls )
+  {
+  smWait<SmClass>( &cls, [] ( SmClass *ptr ) -> bool { return ptr(); } );
+  }
+
+
+//!
+//! \brief smWaitClassPtr Template for automatic using class operator() member-function for stop wait event.
+//!                       SmClass must have member-function with prototype "bool operator () () { ... }".
+//!                       When this function return true waiting stop and task resumed.
+//! \param cls            Any class object which has member-function operator().
+//!
+template <class SmClass>
+void smWaitClassPtr( SmClass *cls )
+  {
+  smWait<SmClass>( cls, [] ( SmClass *ptr ) -> bool { return (*ptr)(); } );
+  }
+
+
+
+//!
+//! \brief smWaitBoolTrue Helper function which wait until bool is set to true
+//! \param arg            Testing bool
+//!
+inline void smWaitBoolTrue( bool *arg )
+  {
+  smWait<bool>( arg, [] ( bool *arg ) -> bool { return *arg; } );
+  }
+
+
+
+//!
+//! \brief smWaitBoolFalse Helper function which wait until bool is set to false
+//! \param arg             Testing bool
+//!
+inline void smWaitBoolFalse( bool *arg )
+  {
+  smWait<bool>( arg, [] ( bool *arg ) -> bool { return !*arg; } );
+  }
+
+
+//!
+//! \brief smWaitIntUntilZero Helper function which wait until int is set to 0
+//! \param arg                Testing int
+//!
+inline void smWaitIntUntilZero( int *arg )
+  {
+  smWait<int>( arg, [] ( int *arg ) -> bool { return *arg == 0; } );
+  }
+
+
+//!
+//! \brief smWaitIntUntilNotZero Helper function which wait until int is set to not 0
+//! \param arg                   Tesming int
+//!
+inline void smWaitIntUntilNotZero( int *arg )
+  {
+  smWait<int>( arg, [] ( int *arg ) -> bool { return *arg != 0; } );
+  }
+
+
+//!
+//! \brief smWaitAndFuture Helper function which wait until fun return true or future will come
+//! \param future          Future value. This value returned by function smTickFuture
+//! \param fun             Function to test. When this function returns true smWaitAndFuture will return true
+//! \return                true when fun return true or false when future will come
+//!
+inline bool smWaitAndFuture( int future, bool (*fun) () )
+  {
+  //Internal structure to hold pair future value and test function
+  struct SmWaitAndTime
+    {
+      int  mFuture;   //Future value
+      bool (*mFun)(); //Test function
+    } w;
+
+  //Fill structure with params
+  w.mFuture = future;
+  w.mFun    = fun;
+
+  //Moment of wait begin for wake-latency histogram
+  int64_t beginUs = smWakeWaitBegin();
+
+  //Call wait function
+  smWaitUntil<SmWaitAndTime>( &w, [] (SmWaitAndTime *w) ->bool { return smTickIsOut(w->mFuture) || w->mFun(); }, future );
+
+  //Return result
+  if( smTickIsOut(future) ) {
+    smWakeRecordFuture( future );
+    return false;
+    }
+  smWakeRecordWait( beginUs );
+  return true;
+  }
+
+
+
+//!
+//! \brief smWaitAndFuture Helper function which wait until fun return true or tickOut elapsed
+//! \param tickOut         TickOut value
+//! \param fun             Function to test. When this function returns true smWaitAndFuture will return true
+//! \return                true when fun return true or false when tickOut elapsed
+//!
+inline bool smWaitAndTick( int tickOut, bool (*fun)() )
+  {
+  return smWaitAndFuture( smTickFuture(tickOut), fun );
+  }
+
+
+
+//!
+//! \brief smWaitAndFutureArg1 Template function which work same as smWaitAndFuture but test function accept one argument
+//! \param future              Future value. This value returned by function smTickFuture
+//! \param arg1                Argument for test function
+//! \param fun                 Function to test. When this function returns true smWaitAndFuture will return true
+//! \return                    true when fun return true or false when future will come
+//!
+template<class SmArg1>
+inline bool smWaitAndFutureArg1( int future, SmArg1 arg1, bool (*fun)( SmArg1 ) )
+  {
+  //Internal structure to hold association future value, test function and argument for test function
+  struct SmWaitAndTime
+    {
+      int     mFuture;            //Future value
+      SmArg1  mArg1;              //Argument for test function
+      bool    (*mFun)( SmArg1 );  //Test function with arg
+    } w;
+
+  //Fill structure with params
+  w.mFuture = future;
+  w.mArg1   = arg1;
+  w.mFun    = fun;
+
+  //Moment of wait begin for wake-latency histogram
+  int64_t beginUs = smWakeWaitBegin();
+
+  //Call wait function
+  smWaitUntil<SmWaitAndTime>( &w, [] (SmWaitAndTime *w) ->bool { return smTickIsOut(w->mFuture) || w->mFun( w->mArg1 ); }, future );
+
+  //Return result
+  if( smTickIsOut(future) ) {
+    smWakeRecordFuture( future );
+    return false;
+    }
+  smWakeRecordWait( beginUs );
+  return true;
+  }
+
+
+
+//!
+//! \brief smWaitAndTickArg1 Helper function which wait until fun return true or tickOut elapsed
+//! \param tickOut           TickOut value
+//! \param arg1              Argument for test function
+//! \param fun               Function to test. When this function returns true smWaitAndFuture will return true
+//! \return                  true when fun return true or false when tickOut elapsed
+//!
+template<class SmArg1>
+inline bool smWaitAndTickArg1( int tickOut, SmArg1 arg1, bool (*fun)( SmArg1 ) )
+  {
+  return smWaitAndFutureArg1<SmArg1>( smTickFuture(tickOut), arg1, fun );
+  }
+
+
+
+//!
+//! \brief smWaitTick Helper function for waiting specified timeOut. It resume this task after timeOut elapsed
+//! \param timeOut    Waiting time out
+//!
+void smWaitTick( int timeOut );
+
+
+//!
+//! \brief smWaitTickUntilHard Helper function for waiting specified moment in the future. When waiting this function do nothing, so it not used multitasking
+//! \param futureTime          Moment in the future
+//!
+inline void smWaitTickUntilHard( int futureTime )
+  {
+  while( !smTickIsOut(futureTime) );
+  }
+
+
+
+//!
+//! \brief smWaitTickHard Helper function for waiting specified timeOut. When waiting this function do nothing, so it not used multitasking
+//! \param timeOut        Waiting time out
+//!
+inline void smWaitTickHard( int timeOut )
+  {
+  smWaitTickUntilHard( smTickFuture(timeOut) );
+  }
+
+
+//!
+//! \brief smWaitTickUntil Helper function for waiting specified moment in the future. It resume this task after system tick count reach this moment
+//! \param futureTime      Moment in the future
+//!
+inline void smWaitTickUntil( int futureTime )
+  {
+  //Wait this moment
+  smWaitUntil<int>( &futureTime, [] ( int *timeOutArg ) -> bool { return smTickIsOut( *timeOutArg ); }, futureTime );
+  smWakeRecordFuture( futureTime );
+  }
+
+
+//!
+//! \brief smWaitUsUntil Helper function for waiting specified moment in the future in microseconds. It resume this task after time reach this moment
+//! \param futureUs      Moment in the future in microseconds. This value returned by function smTimeFutureUs
+//!
+inline void smWaitUsUntil( int64_t futureUs )
+  {
+  smWaitUntilUs<int64_t>( &futureUs, [] ( int64_t *futureArg ) -> bool { return smTimeIsOutUs( *futureArg ); }, futureUs );
+  smWakeRecordFutureUs( futureUs );
+  }
+
+
+//!
+//! \brief smWaitUs  Helper function for waiting specified timeOut in microseconds. It resume this task after timeOut elapsed
+//! \param timeOutUs Waiting time out in microseconds
+//!
+inline void smWaitUs( int64_t timeOutUs )
+  {
+  smWaitUsUntil( smTimeFutureUs(timeOutUs) );
+  }
+
+
+//!
+//! \brief smWaitAndFutureUs Helper function which wait until fun return true or future in microseconds will come
+//! \param futureUs          Future value in microseconds. This value returned by function smTimeFutureUs
+//! \param fun               Function to test. When this function returns true smWaitAndFutureUs will return true
+//! \return                  true when fun return true or false when future will come
+//!
+inline bool smWaitAndFutureUs( int64_t futureUs, bool (*fun) () )
+  {
+  //Internal structure to hold pair future value and test function
+  struct SmWaitAndTimeUs
+    {
+      int64_t mFuture; //Future value
+      bool (*mFun)();  //Test function
+    } w;
+
+  //Fill structure with params
+  w.mFuture = futureUs;
+  w.mFun    = fun;
+
+  //Moment of wait begin for wake-latency histogram
+  int64_t beginUs = smWakeWaitBegin();
+
+  //Call wait function
+  smWaitUntilUs<SmWaitAndTimeUs>( &w, [] (SmWaitAndTimeUs *w) ->bool { return smTimeIsOutUs(w->mFuture) || w->mFun(); }, futureUs );
+
+  //Return result
+  if( smTimeIsOutUs(futureUs) ) {
+    smWakeRecordFutureUs( futureUs );
+    return false;
+    }
+  smWakeRecordWait( beginUs );
+  return true;
+  }
+
+
+//!
+//! \brief smWaitAndUs Helper function which wait until fun return true or timeOut in microseconds elapsed
+//! \param timeOutUs   Time out in microseconds
+//! \param fun         Function to test. When this function returns true smWaitAndUs will return true
+//! \return            true when fun return true or false when timeOut elapsed
+//!
+inline bool smWaitAndUs( int64_t timeOutUs, bool (*fun)() )
+  {
+  return smWaitAndFutureUs( smTimeFutureUs(timeOutUs), fun );
+  }
+
+
+//!
+//! \brief smYeld Simple funtion which switch to another task and resume this task when task loop round
+//!
+void smYeld();
+
+
+//!
+//! \brief smYieldTo Switches directly to task when its wait function returns true, without scan of task ring.
+//!                  Current task remains ready and continues at next scan. Priority of critic tasks is not
+//!                  considered. When task is not ready, it works as smYeld
+//! \param task      Handle of task to switch to
+//! \return          true when switched directly to task
+//!
+bool smYieldTo( SmTaskHandle task );
+
+//! @} waitFunctions
+
+
+
+
+
+
+
+
+/*! \defgroup mutex SaliMLib Mutex
+    \ingroup CPlusPlusPart
+    @{
+
+    */
+
+//!
+//! \brief The SmMutex class Helper class for guard some resource against sharing
+//!
+class SmMutex {
+    bool mBusy; //!< Variable to indicate resource is busy
+  public:
+    //!
+    //! \brief SmMutex Construct initialy not busy resource
+    //!
+    SmMutex() : mBusy(false) {}
+
+    //!
+    //! \brief isLocked Check if resource is busy
+    //! \return         true when resource is busy
+    //!
+    bool isLocked() const { return mBusy; }
+
+    //!
+    //! \brief lock Try lock resource. If resource is busy then it wait until it will be free.
+    //!             If resource is free it locked
+    //!
+    void lock() {
+      if( mBusy )
+        smWaitBoolFalse( &mBusy );
+      mBusy = true;
+      }
+
+    //!
+    //! \brief unlock Unlocks resource
+    //!
+    void unlock() { mBusy = false; smWaitSignal(); }
+  };
+
+
+
+//!
+//! \brief The SmMutexLocker class Helper class for automatic lock and unlock resource by using SmMutex
+//!
+class SmMutexLocker {
+    SmMutex &mMutex; //!< Mutex which guarding resource
+  public:
+    //!
+    //! \brief SmMutexLocker Constructor. It get mutex and try lock it. If resource is busy then it wait until it free
+    //! \param mutex         Mutex which guarding resource
+    //!
+    SmMutexLocker( SmMutex &mutex ) : mMutex(mutex) { mMutex.lock(); }
+
+    //!
+    //! \brief ~SmMutexLocker Destructor automaticly unlock mutex when leave visibility zone
+    //!
+    ~SmMutexLocker() { mMutex.unlock(); }
+  };
+
+
+
+
+//!
+//! \brief The SmMutexFifo class Helper class for guard some resource against sharing with fair (FIFO) ownership transfer.
+//!                           Each locking task takes a ticket and waits for its turn. On unlock ownership is handed
+//!                           directly to the oldest waiter, and only its wait function becomes true
+//!
+class SmMutexFifo {
+    unsigned mTicket;  //!< Ticket for next locking task
+    unsigned mServing; //!< Ticket of task which owns resource (or will own it when resource is free)
+
+    //Internal structure to hold wait params
+    struct SmMutexFifoWait {
+        SmMutexFifo *mMutex;  //!< Waited mutex
+        unsigned     mTicket; //!< Ticket of waiting task
+      };
+  public:
+    //!
+    //! \brief SmMutexFifo Construct initialy not busy resource
+    //!
+    SmMutexFifo() : mTicket(0), mServing(0) {}
+
+    //!
+    //! \brief isLocked Check if resource is busy
+    //! \return         true when resource is busy
+    //!
+    bool isLocked() const { return mTicket != mServing; }
+
+    //!
+    //! \brief waitCount Returns count of tasks waiting for resource
+    //! \return          Count of waiting tasks
+    //!
+    int  waitCount() const { return isLocked() ? static_cast<int>(mTicket - mServing) - 1 : 0; }
+
+    //!
+    //! \brief lock Try lock resource. If resource is busy then it wait until all tasks which locked resource before
+    //!             unlock it. If resource is free it locked
+    //!
+    void lock() {
+      SmMutexFifoWait w = { this, mTicket++ };
+      if( w.mTicket != mServing )
+        smWait<SmMutexFifoWait>( &w, [] ( SmMutexFifoWait *w ) -> bool { return w->mMutex->mServing == w->mTicket; } );
+      }
+
+    //!
+    //! \brief unlock Unlocks resource and hands it to the oldest waiting task
+    //!
+    void unlock() { mServing++; smWaitSignal(); }
+  };
+
+
+
+//!
+//! \brief The SmMutexFifoLocker class Helper class for automatic lock and unlock resource by using SmMutexFifo
+//!
+class SmMutexFifoLocker {
+    SmMutexFifo &mMutex; //!< Mutex which guarding resource
+  public:
+    //!
+    //! \brief SmMutexFifoLocker Constructor. It get mutex and try lock it. If resource is busy then it wait for its turn
+    //! \param mutex             Mutex which guarding resource
+    //!
+    SmMutexFifoLocker( SmMutexFifo &mutex ) : mMutex(mutex) { mMutex.lock(); }
+
+    //!
+    //! \brief ~SmMutexFifoLocker Destructor automaticly unlock mutex when leave visibility zone
+    //!
+    ~SmMutexFifoLocker() { mMutex.unlock(); }
+  };
+
+
+
+
+//!
+//! \brief The SmRwLock class Helper class for guard resource which is read by many tasks and written rarely. Any number
+//!                        of readers may hold lock at once, while writer holds it exclusively. With writer preference
+//!                        new readers wait while any writer waits, so writers are not starved by stream of readers
+//!
+class SmRwLock {
+    int  mReaders;          //!< Count of readers which hold lock
+    int  mWritersWaiting;   //!< Count of writers which wait for lock
+    bool mWriter;           //!< Writer holds lock
+    bool mWriterPreference; //!< New readers wait while any writer waits
+  public:
+    //!
+    //! \brief SmRwLock        Construct initialy not busy resource
+    //! \param writerPreference When true new readers wait while any writer waits
+    //!
+    SmRwLock( bool writerPreference = true ) : mReaders(0), mWritersWaiting(0), mWriter(false), mWriterPreference(writerPreference) {}
+
+    //!
+    //! \brief isLocked Check if resource is busy by reader or writer
+    //! \return         true when resource is busy
+    //!
+    bool isLocked() const { return mWriter || mReaders != 0; }
+
+    //!
+    //! \brief isWriteLocked Check if resource is busy by writer
+    //! \return              true when writer holds resource
+    //!
+    bool isWriteLocked() const { return mWriter; }
+
+    //!
+    //! \brief readerCount Returns count of readers which hold resource
+    //! \return            Count of readers
+    //!
+    int  readerCount() const { return mReaders; }
+
+    //!
+    //! \brief lockRead Lock resource for reading. If writer holds resource (or waits for it with writer preference)
+    //!                 then it wait until writer will unlock it
+    //!
+    void lockRead() {
+      if( !isReadAvailable() )
+        smWait<SmRwLock>( this, [] ( SmRwLock *lock ) -> bool { return lock->isReadAvailable(); } );
+      mReaders++;
+      }
+
+    //!
+    //! \brief unlockRead Unlocks resource locked for reading
+    //!
+    void unlockRead() { mReaders--; smWaitSignal(); }
+
+    //!
+    //! \brief lockWrite Lock resource for writing. If resource is busy then it wait until all readers and writer unlock it
+    //!
+    void lockWrite() {
+      if( isLocked() ) {
+        mWritersWaiting++;
+        smWait<SmRwLock>( this, [] ( SmRwLock *lock ) -> bool { return !lock->isLocked(); } );
+        mWritersWaiting--;
+        }
+      mWriter = true;
+      }
+
+    //!
+    //! \brief unlockWrite Unlocks resource locked for writing
+    //!
+    void unlockWrite() { mWriter = false; smWaitSignal(); }
+
+  private:
+    bool isReadAvailable() const { return !mWriter && !(mWriterPreference && mWritersWaiting); }
+  };
+
+
+
+//!
+//! \brief The SmRwLockReadLocker class Helper class for automatic lock and unlock resource for reading by using SmRwLock
+//!
+class SmRwLockReadLocker {
+    SmRwLock &mLock; //!< Lock which guarding resource
+  public:
+    //!
+    //! \brief SmRwLockReadLocker Constructor. It get lock and try lock it for reading. If writer holds resource then it wait until it free
+    //! \param lock               Lock which guarding resource
+    //!
+    SmRwLockReadLocker( SmRwLock &lock ) : mLock(lock) { mLock.lockRead(); }
+
+    //!
+    //! \brief ~SmRwLockReadLocker Destructor automaticly unlock resource when leave visibility zone
+    //!
+    ~SmRwLockReadLocker() { mLock.unlockRead(); }
+  };
+
+
+
+//!
+//! \brief The SmRwLockWriteLocker class Helper class for automatic lock and unlock resource for writing by using SmRwLock
+//!
+class SmRwLockWriteLocker {
+    SmRwLock &mLock; //!< Lock which guarding resource
+  public:
+    //!
+    //! \brief SmRwLockWriteLocker Constructor. It get lock and try lock it for writing. If resource is busy then it wait until it free
+    //! \param lock                Lock which guarding resource
+    //!
+    SmRwLockWriteLocker( SmRwLock &lock ) : mLock(lock) { mLock.lockWrite(); }
+
+    //!
+    //! \brief ~SmRwLockWriteLocker Destructor automaticly unlock resource when leave visibility zone
+    //!
+    ~SmRwLockWriteLocker() { mLock.unlockWrite(); }
+  };
+
+//! @} mutex
+
+
+
+
+
+
+/*! \defgroup semaphor SaliMLib Semaphor
+    \ingroup CPlusPlusPart
+    @{
+
+    */
+
+//!
+//! \brief The SmSemaphor class Helper class for guard some resource against multiple sharing
+//!
+class SmSemaphor {
+    int mCount; //!< Variable for indicate resource is busy. Resource is busy when mCount reaches 0. If mCount greater 0 then resource is free.
+  public:
+    SmSemaphor( int cnt ) : mCount(cnt) {}
+
+    //!
+    //! \brief isLocked Check if resource is busy
+    //! \return         true when resource is busy
+    //!
+    bool isLocked() const { return mCount == 0; }
+
+    //!
+    //! \brief lock Try lock resource. If resource is busy then it wait until it will be free.
+    //!             If resource is free it locked
+    //!
+    void lock() {
+      if( mCount == 0 )
+        smWaitIntUntilNotZero( &mCount );
+      mCount--;
+      }
+
+    //!
+    //! \brief unlock Unlocks resource
+    //!
+    void unlock() { mCount++; smWaitSignal(); }
+  };
+
+
+
+//!
+//! \brief The SmSemaphorLocker class Helper class for automatic lock and unlock resource by using SmSemaphor
+//!
+class SmSemaphorLocker {
+    SmSemaphor &mSemaphor; //!< Semaphor which guarding resource
+  public:
+    //!
+    //! \brief SmSemaphorLocker Constructor. It get semaphor and try lock it. If resource is busy then it wait until it free
+    //! \param sema             Semaphor which guarding resource
+    //!
+    SmSemaphorLocker( SmSemaphor &sema ) : mSemaphor(sema) { mSemaphor.lock(); }
+
+    //!
+    //! \brief ~SmSemaphorLocker Destructor automaticly unlock semaphor when leave visibility zone
+    //!
+    ~SmSemaphorLocker() { mSemaphor.unlock(); }
+  };
+
+
+
+
+//!
+//! \brief The SmSemaphorFifo class Helper class for guard some resource against multiple sharing with fair (FIFO) access.
+//!                              Each locking task takes a ticket. Task is allowed to access resource when its ticket
+//!                              is less than count of granted accesses, so on unlock only the oldest waiter resumes
+//!
+class SmSemaphorFifo {
+    unsigned mTicket; //!< Ticket for next locking task
+    unsigned mGrant;  //!< Tasks with tickets less than mGrant are allowed to access resource
+
+    //Internal structure to hold wait params
+    struct SmSemaphorFifoWait {
+        SmSemaphorFifo *mSemaphor; //!< Waited semaphor
+        unsigned        mTicket;   //!< Ticket of waiting task
+      };
+  public:
+    SmSemaphorFifo( int cnt ) : mTicket(0), mGrant(cnt) {}
+
+    //!
+    //! \brief isLocked Check if resource is busy
+    //! \return         true when resource is busy
+    //!
+    bool isLocked() const { return static_cast<int>(mGrant - mTicket) <= 0; }
+
+    //!
+    //! \brief lock Try lock resource. If resource is busy then it wait for its turn.
+    //!             If resource is free it locked
+    //!
+    void lock() {
+      SmSemaphorFifoWait w = { this, mTicket++ };
+      if( static_cast<int>(mGrant - w.mTicket) <= 0 )
+        smWait<SmSemaphorFifoWait>( &w, [] ( SmSemaphorFifoWait *w ) -> bool { return static_cast<int>(w->mSemaphor->mGrant - w->mTicket) > 0; } );
+      }
+
+    //!
+    //! \brief unlock Unlocks resource and hands it to the oldest waiting task
+    //!
+    void unlock() { mGrant++; smWaitSignal(); }
+  };
+
+
+
+//!
+//! \brief The SmSemaphorFifoLocker class Helper class for automatic lock and unlock resource by using SmSemaphorFifo
+//!
+class SmSemaphorFifoLocker {
+    SmSemaphorFifo &mSemaphor; //!< Semaphor which guarding resource
+  public:
+    //!
+    //! \brief SmSemaphorFifoLocker Constructor. It get semaphor and try lock it. If resource is busy then it wait for its turn
+    //! \param sema                 Semaphor which guarding resource
+    //!
+    SmSemaphorFifoLocker( SmSemaphorFifo &sema ) : mSemaphor(sema) { mSemaphor.lock(); }
+
+    //!
+    //! \brief ~SmSemaphorFifoLocker Destructor automaticly unlock semaphor when leave visibility zone
+    //!
+    ~SmSemaphorFifoLocker() { mSemaphor.unlock(); }
+  };
+
+//! @} semaphor
+
+
+
+
+
+
+
+
+
+/*! \defgroup eventFlags SaliMLib Event flags
+    \ingroup CPlusPlusPart
+    @{
+
+    */
+
+//!
+//! \brief The SmEventFlags class Group of up to 32 event flags. Flags may be set and cleared from tasks and interrupts.
+//!                            Task may wait for any or all of specified flags, so one wait covers many event sources
+//!                            with constant cost of wait function
+//!
+class SmEventFlags {
+    volatile unsigned mFlags; //!< Event flags
+#if SM_WAKE_HISTOGRAM
+    volatile int64_t  mSignalUs; //!< Moment of last set in microseconds
+#endif
+
+    //Internal structure to hold wait params
+    struct SmEventWait {
+        SmEventFlags *mEvent;  //!< Waited event flags
+        unsigned      mBits;   //!< Mask of waited flags
+        int           mFuture; //!< Time out moment
+      };
+  public:
+#if SM_WAKE_HISTOGRAM
+    SmEventFlags() : mFlags(0), mSignalUs(0) {}
+#else
+    SmEventFlags() : mFlags(0) {}
+#endif
+
+    //!
+    //! \brief flags Returns current state of flags
+    //! \return      Current state of flags
+    //!
+    unsigned flags() const { return mFlags; }
+
+    //!
+    //! \brief set  Sets flags. It may be called from interrupt
+    //! \param bits Mask of flags to set
+    //!
+    void     set( unsigned bits ) {
+      setBits( bits );
+      //Waiters are signaled with interrupts enabled, because RTOS backend notifies tasks here
+      smWaitSignal();
+      }
+
+    //!
+    //! \brief clear Clears flags. It may be called from interrupt. Clearing can not satisfy any waiter, so waiters are not signaled
+    //! \param bits  Mask of flags to clear
+    //!
+    void     clear( unsigned bits ) {
+      SmIrqLocker locker;
+      mFlags &= ~bits;
+      }
+
+    //!
+    //! \brief waitAny    Waits until any of specified flags is set
+    //! \param bits       Mask of waited flags
+    //! \param clearOnExit When true then fired flags are cleared
+    //! \return           Fired flags
+    //!
+    unsigned waitAny( unsigned bits, bool clearOnExit = true ) {
+      SmEventWait w = { this, bits, 0 };
+      if( (mFlags & bits) == 0 ) {
+        smWait<SmEventWait>( &w, [] ( SmEventWait *w ) -> bool { return (w->mEvent->mFlags & w->mBits) != 0; } );
+        wakeRecord( true, 0 );
+        }
+      return fired( bits, clearOnExit );
+      }
+
+    //!
+    //! \brief waitAll    Waits until all of specified flags are set
+    //! \param bits       Mask of waited flags
+    //! \param clearOnExit When true then fired flags are cleared
+    //! \return           Fired flags (equals bits)
+    //!
+    unsigned waitAll( unsigned bits, bool clearOnExit = true ) {
+      SmEventWait w = { this, bits, 0 };
+      if( (mFlags & bits) != bits ) {
+        smWait<SmEventWait>( &w, [] ( SmEventWait *w ) -> bool { return (w->mEvent->mFlags & w->mBits) == w->mBits; } );
+        wakeRecord( true, 0 );
+        }
+      return fired( bits, clearOnExit );
+      }
+
+    //!
+    //! \brief waitAnyAndFuture Waits until any of specified flags is set or future will come
+    //! \param bits             Mask of waited flags
+    //! \param future           Future value. This value returned by function smTickFuture
+    //! \param clearOnExit      When true then fired flags are cleared
+    //! \return                 Fired flags or 0 when future will come
+    //!
+    unsigned waitAnyAndFuture( unsigned bits, int future, bool clearOnExit = true ) {
+      SmEventWait w = { this, bits, future };
+      if( (mFlags & bits) == 0 ) {
+        smWaitUntil<SmEventWait>( &w, [] ( SmEventWait *w ) -> bool { return (w->mEvent->mFlags & w->mBits) != 0 || smTickIsOut(w->mFuture); }, future );
+        wakeRecord( (mFlags & bits) != 0, future );
+        }
+      return fired( bits, clearOnExit );
+      }
+
+    //!
+    //! \brief waitAnyAndTick Waits until any of specified flags is set or tickOut elapsed
+    //! \param bits           Mask of waited flags
+    //! \param tickOut        TickOut value
+    //! \param clearOnExit    When true then fired flags are cleared
+    //! \return               Fired flags or 0 when tickOut elapsed
+    //!
+    unsigned waitAnyAndTick( unsigned bits, int tickOut, bool clearOnExit = true ) { return waitAnyAndFuture( bits, smTickFuture(tickOut), clearOnExit ); }
+
+    //!
+    //! \brief waitAllAndFuture Waits until all of specified flags are set or future will come
+    //! \param bits             Mask of waited flags
+    //! \param future           Future value. This value returned by function smTickFuture
+    //! \param clearOnExit      When true then fired flags are cleared when all of them are set
+    //! \return                 Fired flags. It equals bits if all flags are set, otherwise time out occured
+    //!
+    unsigned waitAllAndFuture( unsigned bits, int future, bool clearOnExit = true ) {
+      SmEventWait w = { this, bits, future };
+      if( (mFlags & bits) != bits ) {
+        smWaitUntil<SmEventWait>( &w, [] ( SmEventWait *w ) -> bool { return (w->mEvent->mFlags & w->mBits) == w->mBits || smTickIsOut(w->mFuture); }, future );
+        wakeRecord( (mFlags & bits) == bits, future );
+        }
+      return fired( bits, clearOnExit && (mFlags & bits) == bits );
+      }
+
+    //!
+    //! \brief waitAllAndTick Waits until all of specified flags are set or tickOut elapsed
+    //! \param bits           Mask of waited flags
+    //! \param tickOut        TickOut value
+    //! \param clearOnExit    When true then fired flags are cleared when all of them are set
+    //! \return               Fired flags. It equals bits if all flags are set, otherwise time out occured
+    //!
+    unsigned waitAllAndTick( unsigned bits, int tickOut, bool clearOnExit = true ) { return waitAllAndFuture( bits, smTickFuture(tickOut), clearOnExit ); }
+
+  private:
+    void     setBits( unsigned bits ) {
+      SmIrqLocker locker;
+      mFlags |= bits;
+#if SM_WAKE_HISTOGRAM
+      mSignalUs = smTimeUs();
+#endif
+      }
+
+    //Records wake latency: from signal when flags fired or from future when time out occured
+    void     wakeRecord( bool signaled, int future ) {
+#if SM_WAKE_HISTOGRAM
+      if( signaled ) smWakeRecordSignal( signalUs() );
+      else           smWakeRecordFuture( future );
+#else
+      (void)signaled; (void)future;
+#endif
+      }
+
+#if SM_WAKE_HISTOGRAM
+    //64-bit moment may be written by interrupt, so it is read under lock
+    int64_t  signalUs() { SmIrqLocker locker; return mSignalUs; }
+#endif
+
+    unsigned fired( unsigned bits, bool clearOnExit ) {
+      SmIrqLocker locker;
+      bits &= mFlags;
+      if( clearOnExit ) mFlags &= ~bits;
+      return bits;
+      }
+  };
+
+
+
+
+#ifndef SM_FIXED_EVENTS
+  #define SM_FIXED_EVENTS 0
+#endif
+
+#if SM_FIXED_EVENTS
+//!
+//! \brief The SmEventPost class Base of fixed containers which posts event flags on container state changes:
+//!                           item bits when item appended, empty bits when item removed. It is enabled by
+//!                           defining global macro SM_FIXED_EVENTS to 1, otherwise it is empty and costs nothing
+//!
+class SmEventPost {
+    SmEventFlags *mEvent;     //!< Event flags to post or nullptr
+    unsigned      mItemBits;  //!< Flags posted when item appended
+    unsigned      mEmptyBits; //!< Flags posted when item removed
+  public:
+    SmEventPost() : mEvent(nullptr), mItemBits(0), mEmptyBits(0) {}
+
+    //!
+    //! \brief setEventFlags Sets event flags posted by container
+    //! \param event         Event flags or nullptr to stop posting
+    //! \param itemBits      Flags posted when item appended to container
+    //! \param emptyBits     Flags posted when item removed from container
+    //!
+    void setEventFlags( SmEventFlags *event, unsigned itemBits, unsigned emptyBits = 0 ) { mEvent = event; mItemBits = itemBits; mEmptyBits = emptyBits; }
+
+  protected:
+    void postItem() { if( mEvent && mItemBits ) mEvent->set( mItemBits ); else smWaitSignal(); }
+    void postEmpty() { if( mEvent && mEmptyBits ) mEvent->set( mEmptyBits ); else smWaitSignal(); }
+  };
+#else
+class SmEventPost {
+  protected:
+    void postItem() { smWaitSignal(); }
+    void postEmpty() { smWaitSignal(); }
+  };
+#endif
+
+//! @} eventFlags
+
+
+
+
+
+
+
+
+/*! \defgroup fixedContainers SaliMLib Containers with fixed size
+    \ingroup CPlusPlusPart
+    @{
+
+    */
+
+
+//!
+//! \brief The SmFixedContainerWait struct Template class to implement waiting for a specified quantity
+//!
+template <class SmPointer, typename SmValue>
+struct SmPointerAndValue {
+    SmPointer *mPointer; //!< Pointer to some object
+    SmValue    mValue;   //!< Some value
+
+    SmPointerAndValue( SmPointer *pointer, SmValue val ) : mPointer(pointer), mValue(val) {}
+  };
+
+
+template <class SmFixedContainer>
+inline void smFixedWaitItem( SmFixedContainer *container )
+  {
+  if( container->itemCount() == 0 )
+    smWait<SmFixedContainer>( container, [] ( SmFixedContainer *q ) -> bool { return q->itemCount() != 0; } );
+  }
+
+template <class SmFixedContainer>
+inline void smFixedWaitItemCount( SmFixedContainer *container, int count )
+  {
+  using SmFixedContainerAndValue = SmPointerAndValue<SmFixedContainer,int>;
+  if( container->itemCount() < count ) {
+    SmFixedContainerAndValue waiter( container, count );
+    smWait<SmFixedContainerAndValue>( &waiter, [] ( SmFixedContainerAndValue *q ) -> bool { return q->mPointer->itemCount() >= q->mValue; } );
+    }
+  }
+
+template <class SmFixedContainer>
+inline void smFixedWaitEmpty( SmFixedContainer *container )
+  {
+  if( container->emptyCount() == 0 )
+    smWait<SmFixedContainer>( container, [] ( SmFixedContainer *q ) -> bool { return q->emptyCount() != 0; } );
+  }
+
+template <class SmFixedContainer>
+inline void smFixedWaitEmptyCount( SmFixedContainer *container, int count )
+  {
+  using SmFixedContainerAndValue = SmPointerAndValue<SmFixedContainer,int>;
+  if( container->emptyCount() < count ) {
+    SmFixedContainerAndValue waiter( container, count );
+    smWait<SmFixedContainerAndValue>( &waiter, [] ( SmFixedContainerAndValue *q ) -> bool { return q->mPointer->emptyCount() >= q->mValue; } );
+    }
+  }
+
+
+
+//!
+//! \brief The SmFixedQueue Templace class for building queue with fixed size
+//!
+template <class Item, int queueSize>
+class SmFixedQueue : public SmEventPost {
+    using SmFixedQueueObject = SmFixedQueue<Item,queueSize>;
+
+    int  mHead;              //!< Index to extract Item
+    int  mTail;              //!< Index to append Item
+    Item mBuffer[queueSize]; //!< Item buffer
+  public:
+    SmFixedQueue() : mHead(0), mTail(0) {}
+
+    //!
+    //! \brief itemCount Returns item count in the queue (Common fixedContainer interface)
+    //! \return          Item count in the queue
+    //!
+    int   itemCount() const { return mHead <= mTail ? mTail - mHead : queueSize - mHead + mTail; }
+
+    //!
+    //! \brief emptyCount Returns count of free places in the queue (Common fixedContainer interface)
+    //! \return           Count of free places
+    //!
+    int   emptyCount() const { return queueSize - 1 - itemCount(); }
+
+    //!
+    //! \brief clear Clear queue contents (Common fixedContainer interface)
+    //!
+    void  clear() { mHead = mTail = 0; postEmpty(); }
+
+    //!
+    //! \brief at    Return item at index beginning from mHead. index value must not exceed elements count (Common fixedContainer interface)
+    //! \param index index is value from 0 to count. When index eq 0 then return head element
+    //! \return      Element with index
+    //!
+    Item &at( int index ) { return mBuffer[smUpperRound(mHead + index, queueSize)]; }
+
+    //!
+    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //!
+    void  waitItem() { smFixedWaitItem<SmFixedQueueObject>( this ); }
+
+    //!
+    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //!
+    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedQueueObject>( this, count ); }
+
+    //!
+    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //!
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedQueueObject>( this ); }
+
+    //!
+    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //!
+    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedQueueObject>( this, count ); }
+
+    //!
+    //! \brief waitContinueItemWaits until there is at least one element as continued block in the container
+    //!
+    void  waitContinueItem() {
+      if( continueCount() == 0 )
+        smWait<SmFixedQueueObject>( this, [] ( SmFixedQueueObject *q ) -> bool { return q->continueCount() != 0; } );
+      }
+
+    //!
+    //! \brief head Return head element
+    //! \return     Element at head
+    //!
+    Item &head() { return mBuffer[mHead]; }
+
+    //!
+    //! \brief deque Retrieves an item from the queue
+    //! \return      Retrived item
+    //!
+    Item  deque() { waitItem(); Item item = mBuffer[headNext()]; postEmpty(); return item; }
+
+    //!
+    //! \brief enque Puts an item in the queue
+    //! \param item  Item to put
+    //!
+    void  enque( Item item ) { waitEmpty(); mBuffer[tailNext()] = item; postItem(); }
+
+    //!
+    //! \brief continueCount Returns the size of a continuous section
+    //! \return              Size of a continuous section
+    //!
+    int   continueCount() const { return mHead <= mTail ? mTail - mHead : queueSize - mHead;}
+
+    //!
+    //! \brief continueBuffer Returns pointer to a continuous section
+    //! \return               Pointer to a continuous section
+    //!
+    Item *continueBuffer() { return mBuffer + mHead; }
+
+    //!
+    //! \brief continueDeque Remove block of count elements from queue
+    //! \param count         Count of removed elements
+    //!
+    void  continueDeque( int count ) { mHead = smUpperRound( mHead + count, queueSize ); postEmpty(); }
+
+  private:
+    int   headNext() { int ptr = mHead; mHead = smUpperRound( mHead + 1, queueSize ); return ptr; }
+
+    int   tailNext() { int ptr = mTail; mTail = smUpperRound( mTail + 1, queueSize ); return ptr; }
+  };
+
+
+
+
+
+//!
+//! \brief The SmFixedStack class
+//!
+template <class Item, int stackSize>
+class SmFixedStack : public SmEventPost {
+    using SmFixedStackObject = SmFixedStack<Item,stackSize>;
+
+    int  mTop;               //!< Top index of stack
+    Item mBuffer[stackSize]; //!< Stack buffer
+  public:
+    SmFixedStack() : mTop(stackSize) {}
+
+
+    //!
+    //! \brief itemCount Returns item count in the stack (Common fixedContainer interface)
+    //! \return          Item count in the stack
+    //!
+    int   itemCount() const { return stackSize - mTop; }
+
+    //!
+    //! \brief emptyCount Returns count of free places in the stack (Common fixedContainer interface)
+    //! \return           Count of free stack
+    //!
+    int   emptyCount() const { return mTop; }
+
+    //!
+    //! \brief clear Clear stack contents (Common fixedContainer interface)
+    //!
+    void  clear() { mTop = stackSize; postEmpty(); }
+
+    //!
+    //! \brief at    Return item at index beginning from top of stack. index value must not exceed elements count (Common fixedContainer interface)
+    //! \param index index is value from 0 to count. When index eq 0 then return top stack element
+    //! \return      Element with index
+    //!
+    Item &at( int index ) { return mBuffer[mTop + index]; }
+
+    //!
+    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //!
+    void  waitItem() { smFixedWaitItem<SmFixedStackObject>( this ); }
+
+    //!
+    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //!
+    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedStackObject>( this, count ); }
+
+    //!
+    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //!
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedStackObject>( this ); }
+
+    //!
+    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //!
+    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedStackObject>( this, count ); }
+
+    //!
+    //! \brief head Return top stack element
+    //! \return     Element at top of stack
+    //!
+    Item &top() const { mBuffer[mTop]; }
+
+    //!
+    //! \brief pop Pop item from stack
+    //! \return    Item from top of stack
+    //!
+    Item pop() {
+      waitItem();
+      Item item = mBuffer[mTop++];
+      postEmpty();
+      return item;
+      }
+
+    //!
+    //! \brief push Push item on to stack
+    //! \param item Pushed item
+    //!
+    void  push( Item item ) {
+      waitEmpty();
+      mBuffer[--mTop] = item;
+      postItem();
+      }
+
+
+  };
+
+
+
+
+//!
+//! \brief The SmFixedBuffer class
+//!
+template <class Item, int bufferSize>
+class SmFixedBuffer : public SmEventPost {
+    using SmFixedBufferObject = SmFixedBuffer<Item,bufferSize>;
+
+    int  mCount;              //!< Element count
+    Item mBuffer[bufferSize]; //!< Element buffer
+  public:
+    SmFixedBuffer() : mCount(0) {}
+
+
+
+    //!
+    //! \brief itemCount Returns item count in the buffer (Common fixedContainer interface)
+    //! \return          Item count in the buffer
+    //!
+    int   itemCount() const { return mCount; }
+
+    //!
+    //! \brief emptyCount Returns count of free places in the buffer (Common fixedContainer interface)
+    //! \return           Count of free places
+    //!
+    int   emptyCount() const { return bufferSize - mCount; }
+
+    //!
+    //! \brief clear Clear buffer contents (Common fixedContainer interface)
+    //!
+    void  clear() { mCount = 0; postEmpty(); }
+
+    //!
+    //! \brief at    Return item at index beginning from begin of buffer. index value must not exceed elements count (Common fixedContainer interface)
+    //! \param index index is value from 0 to count. When index eq 0 then return first element
+    //! \return      Element with index
+    //!
+    Item &at( int index ) { return mBuffer[index]; }
+
+    //!
+    //! \brief at    Return item at index beginning from begin of buffer. index value must not exceed elements count
+    //! \param index index is value from 0 to count. When index eq 0 then return first element
+    //! \return      Element with index
+    //!
+    const Item &at( int index ) const { return mBuffer[index]; }
+
+    //!
+    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //!
+    void  waitItem() { smFixedWaitItem<SmFixedBufferObject>( this ); }
+
+    //!
+    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //!
+    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedBufferObject>( this, count ); }
+
+    //!
+    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //!
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedBufferObject>( this ); }
+
+    //!
+    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //!
+    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedBufferObject>( this, count ); }
+
+
+    //!
+    //! \brief append Append one item to end of buffer
+    //! \param item   Item to append
+    //!
+    void  append( Item item ) {
+      //Wait for emty space for one item
+      waitEmpty();
+      //Place item
+      mBuffer[mCount++] = item;
+      postItem();
+      }
+
+    //!
+    //! \brief append Append block of count items to end of buffer
+    //! \param items  Pointer to block of items
+    //! \param count  Count of appended items
+    //!
+    void  append( Item *items, int count ) {
+      //Wait for emty space for count items
+      waitEmptyCount( count );
+      //Place items
+      while( count-- )
+        mBuffer[mCount++] = *items++;
+      postItem();
+      }
+
+    //!
+    //! \brief insert Inserts one item in specified position of buffer
+    //! \param item   Inserted item
+    //! \param pos    Position to which item will be inserted
+    //!
+    void  insert( Item item, int pos ) {
+      //Wait for emty space for one item
+      waitEmpty();
+      mCount++;
+      //Free space to item. We shift all right-stand items to one position to right
+      for( int i = mCount - 1; i > pos; i-- )
+        mBuffer[i] = mBuffer[i - 1];
+      //Place item
+      mBuffer[pos] = item;
+      postItem();
+      }
+
+    //!
+    //! \brief insert Inserts block of count items in specified position of buffer
+    //! \param items  Inserted item block
+    //! \param pos    Position to which item block will be inserted
+    //! \param count  Count of inserted items
+    //!
+    void  insert( Item *items, int pos, int count ) {
+      //Wait for emty space for count items
+      waitEmptyCount(count);
+      mCount += count;
+      //Free space to item block. We shift all right-stand items to count positions to right
+      for( int i = mCount - 1; i >= pos + count; i-- )
+        mBuffer[i] = mBuffer[i - count];
+      //Place items
+      while( count-- )
+        mBuffer[pos++] = *items++;
+      postItem();
+      }
+
+    //!
+    //! \brief remove Removes one item from specified position of buffer
+    //! \param pos    Position of removed item
+    //!
+    void  remove( int pos ) {
+      waitItem();
+      for( pos++; pos < mCount; pos++ )
+        mBuffer[pos - 1] = mBuffer[pos];
+      mCount--;
+      postEmpty();
+      }
+
+    //!
+    //! \brief remove Removes block of items begining from specified position of buffer
+    //! \param pos    Position of removed item block
+    //! \param count  Count of removed items
+    //!
+    void  remove( int pos, int count ) {
+      waitItemCount( count );
+      for( pos += count; pos < mCount; pos++ )
+        mBuffer[pos - count] = mBuffer[pos];
+      mCount -= count;
+      postEmpty();
+      }
+
+
+    //!
+    //! \brief receiv Receiv single item into buffer. Item placed into buffer if there is anough space in them
+    //! \param item   Received item
+    //!
+    void receiv( Item item ) {
+      if( emptyCount() ) {
+        mBuffer[mCount++] = item;
+        postItem();
+        }
+      }
+
+  };
+
+
+
+//!
+//! \brief The SmFixedSortedMap class Template class for map with fixed size. Entries are held in SmFixedBuffer sorted
+//!                                by key, so lookup is binary search and takes O(log n). Insert and remove shift
+//!                                entries after position. Key order is defined by comparator SmCompare
+//!
+template <class Key, class Value, int mapSize, class SmCompare = SmLess<Key> >
+class SmFixedSortedMap {
+  public:
+    //!
+    //! \brief The SmEntry struct Entry of map
+    //!
+    struct SmEntry {
+        Key   mKey;   //!< Key of entry
+        Value mValue; //!< Value of entry
+      };
+
+  private:
+    SmFixedBuffer<SmEntry,mapSize> mBuffer;  //!< Entries sorted by key
+    SmCompare                      mCompare; //!< Key comparator
+  public:
+
+    //!
+    //! \brief itemCount Returns item count in the map (Common fixedContainer interface)
+    //! \return          Item count in the map
+    //!
+    int   itemCount() const { return mBuffer.itemCount(); }
+
+    //!
+    //! \brief emptyCount Returns count of free places in the map (Common fixedContainer interface)
+    //! \return           Count of free places
+    //!
+    int   emptyCount() const { return mBuffer.emptyCount(); }
+
+    //!
+    //! \brief clear Clear map contents (Common fixedContainer interface)
+    //!
+    void  clear() { mBuffer.clear(); }
+
+    //!
+    //! \brief at    Return entry at index in sorted order. index value must not exceed elements count (Common fixedContainer interface)
+    //! \param index index is value from 0 to count. When index eq 0 then return entry with smallest key
+    //! \return      Entry with index
+    //!
+    SmEntry &at( int index ) { return mBuffer.at(index); }
+
+    //!
+    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //!
+    void  waitItem() { mBuffer.waitItem(); }
+
+    //!
+    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //!
+    void  waitItemCount( int count ) { mBuffer.waitItemCount( count ); }
+
+    //!
+    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //!
+    void  waitEmpty() { mBuffer.waitEmpty(); }
+
+    //!
+    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //!
+    void  waitEmptyCount( int count ) { mBuffer.waitEmptyCount( count ); }
+
+#if SM_FIXED_EVENTS
+    //!
+    //! \brief setEventFlags Sets event flags posted by map
+    //! \param event         Event flags or nullptr to stop posting
+    //! \param itemBits      Flags posted when entry inserted
+    //! \param emptyBits     Flags posted when entry removed
+    //!
+    void  setEventFlags( SmEventFlags *event, unsigned itemBits, unsigned emptyBits = 0 ) { mBuffer.setEventFlags( event, itemBits, emptyBits ); }
+#endif
+
+    //!
+    //! \brief lowerBound Returns position of first entry which key is not less than key. Binary search takes O(log n)
+    //! \param key        Key to search
+    //! \return           Position from 0 to count inclusive
+    //!
+    int   lowerBound( const Key &key ) const {
+      int low  = 0;
+      int high = mBuffer.itemCount();
+      while( low < high ) {
+        int middle = (low + high) / 2;
+        if( mCompare( mBuffer.at(middle).mKey, key ) ) low = middle + 1;
+        else high = middle;
+        }
+      return low;
+      }
+
+    //!
+    //! \brief indexOf Returns position of entry with key
+    //! \param key     Key to search
+    //! \return        Position of entry or -1 when there is no entry with key
+    //!
+    int   indexOf( const Key &key ) const {
+      int pos = lowerBound( key );
+      return pos < mBuffer.itemCount() && !mCompare( key, mBuffer.at(pos).mKey ) ? pos : -1;
+      }
+
+    //!
+    //! \brief contains Check if there is entry with key
+    //! \param key      Key to search
+    //! \return         true when entry with key present
+    //!
+    bool  contains( const Key &key ) const { return indexOf( key ) >= 0; }
+
+    //!
+    //! \brief remove Removes entry with key
+    //! \param key    Key of removed entry
+    //! \return       true when entry was removed or false when there is no entry with key
+    //!
+    bool  remove( const Key &key ) {
+      int pos = indexOf( key );
+      if( pos < 0 ) return false;
+      mBuffer.remove( pos );
+      return true;
+      }
+
+    //!
+    //! \brief find Finds value with key
+    //! \param key  Key to search
+    //! \return     Pointer to value or nullptr when there is no entry with key
+    //!
+    Value *find( const Key &key ) {
+      int pos = indexOf( key );
+      return pos < 0 ? nullptr : &(mBuffer.at(pos).mValue);
+      }
+
+    //!
+    //! \brief insert Inserts entry with key and value or replaces value of existing entry. If there is no space for
+    //!               new entry then it wait until entry will be removed
+    //! \param key    Key of entry
+    //! \param value  Value of entry
+    //! \return       true when new entry inserted or false when value of existing entry replaced
+    //!
+    bool  insert( const Key &key, const Value &value ) {
+      int pos = indexOf( key );
+      if( pos < 0 && mBuffer.emptyCount() == 0 ) {
+        //Waiting for space may change map, so key is searched again
+        mBuffer.waitEmpty();
+        pos = indexOf( key );
+        }
+      if( pos >= 0 ) {
+        mBuffer.at(pos).mValue = value;
+        return false;
+        }
+      SmEntry entry;
+      entry.mKey   = key;
+      entry.mValue = value;
+      mBuffer.insert( entry, lowerBound( key ) );
+      return true;
+      }
+  };
+
+
+
+
+//!
+//! \brief The SmFixedSortedSet class Template class for set with fixed size. Keys are held in SmFixedBuffer sorted,
+//!                                so lookup is binary search and takes O(log n). Insert and remove shift keys after
+//!                                position. Key order is defined by comparator SmCompare
+//!
+template <class Key, int setSize, class SmCompare = SmLess<Key> >
+class SmFixedSortedSet {
+    SmFixedBuffer<Key,setSize> mBuffer;  //!< Keys sorted
+    SmCompare                  mCompare; //!< Key comparator
+  public:
+
+    //!
+    //! \brief itemCount Returns item count in the set (Common fixedContainer interface)
+    //! \return          Item count in the set
+    //!
+    int   itemCount() const { return mBuffer.itemCount(); }
+
+    //!
+    //! \brief emptyCount Returns count of free places in the set (Common fixedContainer interface)
+    //! \return           Count of free places
+    //!
+    int   emptyCount() const { return mBuffer.emptyCount(); }
+
+    //!
+    //! \brief clear Clear set contents (Common fixedContainer interface)
+    //!
+    void  clear() { mBuffer.clear(); }
+
+    //!
+    //! \brief at    Return key at index in sorted order. index value must not exceed elements count (Common fixedContainer interface)
+    //! \param index index is value from 0 to count. When index eq 0 then return key with smallest key
+    //! \return      Key with index
+    //!
+    Key &at( int index ) { return mBuffer.at(index); }
+
+    //!
+    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //!
+    void  waitItem() { mBuffer.waitItem(); }
+
+    //!
+    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //!
+    void  waitItemCount( int count ) { mBuffer.waitItemCount( count ); }
+
+    //!
+    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //!
+    void  waitEmpty() { mBuffer.waitEmpty(); }
+
+    //!
+    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //!
+    void  waitEmptyCount( int count ) { mBuffer.waitEmptyCount( count ); }
+
+#if SM_FIXED_EVENTS
+    //!
+    //! \brief setEventFlags Sets event flags posted by set
+    //! \param event         Event flags or nullptr to stop posting
+    //! \param itemBits      Flags posted when key inserted
+    //! \param emptyBits     Flags posted when key removed
+    //!
+    void  setEventFlags( SmEventFlags *event, unsigned itemBits, unsigned emptyBits = 0 ) { mBuffer.setEventFlags( event, itemBits, emptyBits ); }
+#endif
+
+    //!
+    //! \brief lowerBound Returns position of first key which key is not less than key. Binary search takes O(log n)
+    //! \param key        Key to search
+    //! \return           Position from 0 to count inclusive
+    //!
+    int   lowerBound( const Key &key ) const {
+      int low  = 0;
+      int high = mBuffer.itemCount();
+      while( low < high ) {
+        int middle = (low + high) / 2;
+        if( mCompare( mBuffer.at(middle), key ) ) low = middle + 1;
+        else high = middle;
+        }
+      return low;
+      }
+
+    //!
+    //! \brief indexOf Returns position of key with key
+    //! \param key     Key to search
+    //! \return        Position of key or -1 when there is no key with key
+    //!
+    int   indexOf( const Key &key ) const {
+      int pos = lowerBound( key );
+      return pos < mBuffer.itemCount() && !mCompare( key, mBuffer.at(pos) ) ? pos : -1;
+      }
+
+    //!
+    //! \brief contains Check if there is key with key
+    //! \param key      Key to search
+    //! \return         true when key with key present
+    //!
+    bool  contains( const Key &key ) const { return indexOf( key ) >= 0; }
+
+    //!
+    //! \brief remove Removes key with key
+    //! \param key    Key of removed key
+    //! \return       true when key was removed or false when there is no key with key
+    //!
+    bool  remove( const Key &key ) {
+      int pos = indexOf( key );
+      if( pos < 0 ) return false;
+      mBuffer.remove( pos );
+      return true;
+      }
+
+    //!
+    //! \brief insert Inserts key. If there is no space for key then it wait until key will be removed
+    //! \param key    Inserted key
+    //! \return       true when key inserted or false when key already present
+    //!
+    bool  insert( const Key &key ) {
+      if( contains( key ) ) return false;
+      if( mBuffer.emptyCount() == 0 ) {
+        //Waiting for space may change set, so key is searched again
+        mBuffer.waitEmpty();
+        if( contains( key ) ) return false;
+        }
+      mBuffer.insert( key, lowerBound( key ) );
+      return true;
+      }
+  };
+
+
+
+
+//!
+//! \brief The SmFixedHashMap class Template class for hash map with fixed size. Entries are placed in table by hash of
+//!                              key with linear probing, so lookup, insert and remove take constant time in average.
+//!                              Remove shifts following entries of probe chain back, so there is no deleted marks
+//!                              and lookup does not degrade after many removes. mapSize must be power of two, map
+//!                              holds up to mapSize - 1 entries. Hash of key is calculated by SmHashFunction
+//!
+template <class Key, class Value, int mapSize, class SmHashFunction = SmHash<Key> >
+class SmFixedHashMap : public SmEventPost {
+    using SmFixedHashMapObject = SmFixedHashMap<Key,Value,mapSize,SmHashFunction>;
+
+    static_assert( mapSize > 1 && (mapSize & (mapSize - 1)) == 0, "Map size must be power of two" );
+  public:
+    //!
+    //! \brief The SmEntry struct Entry of map
+    //!
+    struct SmEntry {
+        Key   mKey;   //!< Key of entry
+        Value mValue; //!< Value of entry
+      };
+
+  private:
+    int            mCount;           //!< Entry count
+    bool           mUsed[mapSize];   //!< Flags of used places of table
+    SmEntry        mBuffer[mapSize]; //!< Table of entries
+    SmHashFunction mHash;            //!< Hash function
+  public:
+    SmFixedHashMap() : mCount(0) { for( int i = 0; i < mapSize; i++ ) mUsed[i] = false; }
+
+    //!
+    //! \brief itemCount Returns entry count in the map (Common fixedContainer interface)
+    //! \return          Entry count in the map
+    //!
+    int   itemCount() const { return mCount; }
+
+    //!
+    //! \brief emptyCount Returns count of free places in the map (Common fixedContainer interface)
+    //! \return           Count of free places
+    //!
+    int   emptyCount() const { return mapSize - 1 - mCount; }
+
+    //!
+    //! \brief clear Clear map contents (Common fixedContainer interface)
+    //!
+    void  clear() {
+      for( int i = 0; i < mapSize; i++ ) mUsed[i] = false;
+      mCount = 0;
+      postEmpty();
+      }
+
+    //!
+    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //!
+    void  waitItem() { smFixedWaitItem<SmFixedHashMapObject>( this ); }
+
+    //!
+    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //!
+    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedHashMapObject>( this, count ); }
+
+    //!
+    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //!
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedHashMapObject>( this ); }
+
+    //!
+    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //!
+    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedHashMapObject>( this, count ); }
+
+    //!
+    //! \brief find Finds value with key
+    //! \param key  Key to search
+    //! \return     Pointer to value or nullptr when there is no entry with key
+    //!
+    Value *find( const Key &key ) {
+      int pos = probe( key );
+      return mUsed[pos] ? &(mBuffer[pos].mValue) : nullptr;
+      }
+
+    //!
+    //! \brief contains Check if there is entry with key
+    //! \param key      Key to search
+    //! \return         true when entry with key present
+    //!
+    bool  contains( const Key &key ) const { return mUsed[probe( key )]; }
+
+    //!
+    //! \brief insert Inserts entry with key and value or replaces value of existing entry. If there is no space for
+    //!               new entry then it wait until entry will be removed
+    //! \param key    Key of entry
+    //! \param value  Value of entry
+    //! \return       true when new entry inserted or false when value of existing entry replaced
+    //!
+    bool  insert( const Key &key, const Value &value ) {
+      int pos = probe( key );
+      if( !mUsed[pos] && emptyCount() == 0 ) {
+        //Waiting for space may change map, so key is searched again
+        waitEmpty();
+        pos = probe( key );
+        }
+      mBuffer[pos].mValue = value;
+      if( mUsed[pos] )
+        return false;
+      mBuffer[pos].mKey = key;
+      mUsed[pos] = true;
+      mCount++;
+      postItem();
+      return true;
+      }
+
+    //!
+    //! \brief remove Removes entry with key
+    //! \param key    Key of removed entry
+    //! \return       true when entry was removed or false when there is no entry with key
+    //!
+    bool  remove( const Key &key ) {
+      int hole = probe( key );
+      if( !mUsed[hole] ) return false;
+      //Shift back entries of probe chain which may be placed to hole
+      for( int pos = next(hole); mUsed[pos]; pos = next(pos) ) {
+        int home = mHash( mBuffer[pos].mKey ) & (mapSize - 1);
+        //Entry may be moved when hole is between its home place and current place
+        if( ((pos - home) & (mapSize - 1)) >= ((pos - hole) & (mapSize - 1)) ) {
+          mBuffer[hole] = mBuffer[pos];
+          hole = pos;
+          }
+        }
+      mUsed[hole] = false;
+      mCount--;
+      postEmpty();
+      return true;
+      }
+
+  private:
+    int   next( int pos ) const { return (pos + 1) & (mapSize - 1); }
+
+    //Returns place of entry with key or free place where entry with key must be inserted.
+    //There is at least one free place, so probe always ends
+    int   probe( const Key &key ) const {
+      int pos = mHash( key ) & (mapSize - 1);
+      while( mUsed[pos] && !(mBuffer[pos].mKey == key) )
+        pos = next(pos);
+      return pos;
+      }
+  };
+
+
+
+
+//!
+//! \brief The SmFixedPoolCounters struct Template for optional statistics of SmFixedPool. When statistics is disabled
+//!                                   (default) counters are empty and cost nothing
+//!
+template <bool statistics>
+struct SmFixedPoolCounters {
+    //!
+    //! \brief highWater Returns maximum count of simultaneously allocated blocks. Always 0 when statistics disabled
+    //! \return          Maximum count of simultaneously allocated blocks
+    //!
+    int   highWater() const { return 0; }
+
+    //!
+    //! \brief failCount Returns count of allocation requests when pool was empty. Always 0 when statistics disabled
+    //! \return          Count of failed (or waited) allocations
+    //!
+    int   failCount() const { return 0; }
+
+    //!
+    //! \brief clearCounters Resets statistics counters
+    //!
+    void  clearCounters() {}
+
+  protected:
+    void  counterAllocate( int ) {}
+    void  counterFail() {}
+  };
 
-    */
 
 
 //!
-//! \brief The SmFixedContainerWait struct Template class to implement waiting for a specified quantity
+//! \brief The SmFixedPoolCounters<true> struct Enabled statistics of SmFixedPool
 //!
-template <class SmPointer, typename SmValue>
-struct SmPointerAndValue {
-    SmPointer *mPointer; //!< Pointer to some object
-    SmValue    mValue;   //!< Some value
+template <>
+struct SmFixedPoolCounters<true> {
+    int mHighWater; //!< Maximum count of simultaneously allocated blocks
+    int mFailCount; //!< Count of allocation requests when pool was empty
 
-    SmPointerAndValue( SmPointer *pointer, SmValue val ) : mPointer(pointer), mValue(val) {}
-  };
+    SmFixedPoolCounters() : mHighWater(0), mFailCount(0) {}
 
+    int   highWater() const { return mHighWater; }
 
-template <class SmFixedContainer>
-inline void smFixedWaitItem( SmFixedContainer *container )
-  {
-  if( container->itemCount() == 0 )
-    smWait<SmFixedContainer>( container, [] ( SmFixedContainer *q ) -> bool { return q->itemCount() != 0; } );
-  }
+    int   failCount() const { return mFailCount; }
 
-template <class SmFixedContainer>
-inline void smFixedWaitItemCount( SmFixedContainer *container, int count )
-  {
-  using SmFixedContainerAndValue = SmPointerAndValue<SmFixedContainer,int>;
-  if( container->itemCount() < count )
-    smWait<SmFixedContainerAndValue>( SmFixedContainerAndValue( container, count ), [] ( SmFixedContainerAndValue *q ) -> bool { return q->mPointer->itemCount() >= q->mValue; } );
-  }
+    void  clearCounters() { mHighWater = mFailCount = 0; }
 
-template <class SmFixedContainer>
-inline void smFixedWaitEmpty( SmFixedContainer *container )
-  {
-  if( container->emptyCount() == 0 )
-    smWait<SmFixedContainer>( container, [] ( SmFixedContainer *q ) -> bool { return q->emptyCount() != 0; } );
-  }
+  protected:
+    void  counterAllocate( int count ) { if( count > mHighWater ) mHighWater = count; }
+    void  counterFail() { mFailCount++; }
+  };
 
-template <class SmFixedContainer>
-inline void smFixedWaitEmptyCount( SmFixedContainer *container, int count )
-  {
-  using SmFixedContainerAndValue = SmPointerAndValue<SmFixedContainer,int>;
-  if( container->emptyCount() < count )
-    smWait<SmFixedContainerAndValue>( SmFixedContainerAndValue( container, count ), [] ( SmFixedContainerAndValue *q ) -> bool { return q->mPointer->emptyCount() >= q->mValue; } );
-  }
 
 
 
 //!
-//! \brief The SmFixedQueue Templace class for building queue with fixed size
+//! \brief The SmFixedPool class Template class for pool of fixed size blocks. Allocation and release take constant time
 //!
-template <class Item, int queueSize>
-class SmFixedQueue {
-    using SmFixedQueueObject = SmFixedQueue<Item,queueSize>;
+template <class Item, int poolSize, bool statistics = false>
+class SmFixedPool : public SmFixedPoolCounters<statistics>, public SmEventPost {
+    using SmFixedPoolObject = SmFixedPool<Item,poolSize,statistics>;
 
-    int  mHead;              //!< Index to extract Item
-    int  mTail;              //!< Index to append Item
-    Item mBuffer[queueSize]; //!< Item buffer
+    int  mFree;              //!< Index of first free block in free list or -1 if no free blocks
+    int  mCount;             //!< Count of allocated blocks
+    int  mNext[poolSize];    //!< Free list. For each free block contains index of next free block
+    Item mBuffer[poolSize];  //!< Blocks buffer
   public:
-    SmFixedQueue() : mHead(0), mTail(0) {}
+    SmFixedPool() { clear(); }
 
     //!
-    //! \brief itemCount Returns item count in the queue (Common fixedContainer interface)
-    //! \return          Item count in the queue
+    //! \brief itemCount Returns count of allocated blocks (Common fixedContainer interface)
+    //! \return          Count of allocated blocks
     //!
-    int   itemCount() const { return mHead <= mTail ? mTail - mHead : queueSize - mHead + mTail; }
+    int   itemCount() const { return mCount; }
 
     //!
-    //! \brief emptyCount Returns count of free places in the queue (Common fixedContainer interface)
-    //! \return           Count of free places
+    //! \brief emptyCount Returns count of free blocks (Common fixedContainer interface)
+    //! \return           Count of free blocks
     //!
-    int   emptyCount() const { return queueSize - 1 - itemCount(); }
+    int   emptyCount() const { return poolSize - mCount; }
 
     //!
-    //! \brief clear Clear queue contents (Common fixedContainer interface)
+    //! \brief clear Returns all blocks to pool (Common fixedContainer interface)
     //!
-    void  clear() { mHead = mTail = 0; }
+    void  clear() {
+      for( int i = 0; i < poolSize; i++ )
+        mNext[i] = i + 1;
+      mNext[poolSize - 1] = -1;
+      mFree = 0;
+      mCount = 0;
+      postEmpty();
+      }
 
     //!
-    //! \brief at    Return item at index beginning from mHead. index value must not exceed elements count (Common fixedContainer interface)
-    //! \param index index is value from 0 to count. When index eq 0 then return head element
-    //! \return      Element with index
+    //! \brief at    Return block with index regardless of it is allocated or not (Common fixedContainer interface)
+    //! \param index index is value from 0 to poolSize
+    //! \return      Block with index
     //!
-    Item &at( int index ) { return mBuffer[smUpperRound(mHead + index, queueSize)]; }
+    Item &at( int index ) { return mBuffer[index]; }
 
     //!
-    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //! \brief waitItem Waits until there is at least one allocated block (Common fixedContainer interface)
     //!
-    void  waitItem() { smFixedWaitItem<SmFixedQueueObject>( this ); }
+    void  waitItem() { smFixedWaitItem<SmFixedPoolObject>( this ); }
 
     //!
-    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //! \brief waitItemCount Waits until there is at least count allocated blocks (Common fixedContainer interface)
     //!
-    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedQueueObject>( this, count ); }
+    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedPoolObject>( this, count ); }
 
     //!
-    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //! \brief waitEmpty Waits until there is at least one free block (Common fixedContainer interface)
     //!
-    void  waitEmpty() { smFixedWaitEmpty<SmFixedQueueObject>( this ); }
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedPoolObject>( this ); }
 
     //!
-    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //! \brief waitEmptyCount Waits until there is at least count free blocks (Common fixedContainer interface)
     //!
-    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedQueueObject>( this, count ); }
+    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedPoolObject>( this, count ); }
 
     //!
-    //! \brief waitContinueItemWaits until there is at least one element as continued block in the container
+    //! \brief allocate Allocates block from pool. If there is no free blocks then it wait until block will be released
+    //! \return         Pointer to allocated block
     //!
-    void  waitContinueItem() {
-      if( continueCount() == 0 )
-        smWait<SmFixedQueueObject>( this, [] ( SmFixedQueueObject *q ) -> bool { return q->continueCount() != 0; } );
+    Item *allocate() {
+      if( mFree < 0 ) {
+        this->counterFail();
+        waitEmpty();
+        }
+      return take();
       }
 
     //!
-    //! \brief head Return head element
-    //! \return     Element at head
-    //!
-    Item &head() { return mBuffer[mHead]; }
-
-    //!
-    //! \brief deque Retrieves an item from the queue
-    //! \return      Retrived item
-    //!
-    Item  deque() { waitItem(); return mBuffer[headNext()]; }
-
-    //!
-    //! \brief enque Puts an item in the queue
-    //! \param item  Item to put
+    //! \brief tryAllocate Allocates block from pool without waiting
+    //! \return            Pointer to allocated block or nullptr if there is no free blocks
     //!
-    void  enque( Item item ) { waitEmpty(); mBuffer[tailNext()] = item; }
+    Item *tryAllocate() {
+      if( mFree < 0 ) {
+        this->counterFail();
+        return nullptr;
+        }
+      return take();
+      }
 
     //!
-    //! \brief continueCount Returns the size of a continuous section
-    //! \return              Size of a continuous section
+    //! \brief release Returns block to pool
+    //! \param item    Pointer to block previously allocated from this pool
     //!
-    int   continueCount() const { return mHead <= mTail ? mTail - mHead : queueSize - mHead;}
+    void  release( Item *item ) {
+      int i = index( item );
+      mNext[i] = mFree;
+      mFree = i;
+      mCount--;
+      postEmpty();
+      }
 
     //!
-    //! \brief continueBuffer Returns pointer to a continuous section
-    //! \return               Pointer to a continuous section
+    //! \brief index Returns index of block
+    //! \param item  Pointer to block of this pool
+    //! \return      Index of block
     //!
-    Item *continueBuffer() { return mBuffer + mHead; }
+    int   index( const Item *item ) const { return static_cast<int>(item - mBuffer); }
 
     //!
-    //! \brief continueDeque Remove block of count elements from queue
-    //! \param count         Count of removed elements
+    //! \brief isOwner Checks if block belongs to this pool
+    //! \param item    Pointer to block
+    //! \return        true if block belongs to this pool
     //!
-    void  continueDeque( int count ) { mHead = smUpperRound( mHead + count, queueSize ); }
+    bool  isOwner( const Item *item ) const { return item >= mBuffer && item < mBuffer + poolSize; }
 
   private:
-    int   headNext() { int ptr = mHead; mHead = smUpperRound( mHead + 1, queueSize ); return ptr; }
-
-    int   tailNext() { int ptr = mTail; mTail = smUpperRound( mTail + 1, queueSize ); return ptr; }
+    Item *take() {
+      int i = mFree;
+      mFree = mNext[i];
+      this->counterAllocate( ++mCount );
+      postItem();
+      return mBuffer + i;
+      }
   };
 
 
 
 
-
 //!
-//! \brief The SmFixedStack class
+//! \brief The SmFixedChannel class Template class for zero-copy message passing between tasks. Channel transfers only
+//!                              pointers to blocks of SmFixedPool, so cost of send and receive not depends on message size.
+//!                              Block ownership moves from producer (allocate, send) to consumer (receive, release).
+//!                              Several channels may share one pool, so message may be forwarded without copying.
 //!
-template <class Item, int stackSize>
-class SmFixedStack {
-    using SmFixedStackObject = SmFixedStack<Item,stackSize>;
+template <class Item, int poolSize, bool statistics = false>
+class SmFixedChannel {
+    using SmFixedChannelObject = SmFixedChannel<Item,poolSize,statistics>;
+    using SmFixedChannelPool   = SmFixedPool<Item,poolSize,statistics>;
 
-    int  mTop;               //!< Top index of stack
-    Item mBuffer[stackSize]; //!< Stack buffer
+    SmFixedChannelPool              &mPool;  //!< Pool of message blocks
+    SmFixedQueue<Item*,poolSize + 1> mQueue; //!< Queue of sent blocks. It can hold all blocks of pool, so send never waits
   public:
-    SmFixedStack() : mTop(stackSize) {}
-
+    SmFixedChannel( SmFixedChannelPool &pool ) : mPool(pool) {}
 
     //!
-    //! \brief itemCount Returns item count in the stack (Common fixedContainer interface)
-    //! \return          Item count in the stack
+    //! \brief itemCount Returns count of messages in the channel (Common fixedContainer interface)
+    //! \return          Count of messages
     //!
-    int   itemCount() const { return stackSize - mTop; }
+    int   itemCount() const { return mQueue.itemCount(); }
 
     //!
-    //! \brief emptyCount Returns count of free places in the stack (Common fixedContainer interface)
-    //! \return           Count of free stack
+    //! \brief emptyCount Returns count of free blocks in the pool (Common fixedContainer interface)
+    //! \return           Count of free blocks available to allocate
     //!
-    int   emptyCount() const { return mTop; }
+    int   emptyCount() const { return mPool.emptyCount(); }
 
     //!
-    //! \brief clear Clear stack contents (Common fixedContainer interface)
+    //! \brief clear Removes all messages from the channel and returns their blocks to the pool (Common fixedContainer interface)
     //!
-    void  clear() { mTop = stackSize; }
+    void  clear() {
+      while( mQueue.itemCount() )
+        mPool.release( mQueue.deque() );
+      }
 
     //!
-    //! \brief at    Return item at index beginning from top of stack. index value must not exceed elements count (Common fixedContainer interface)
-    //! \param index index is value from 0 to count. When index eq 0 then return top stack element
-    //! \return      Element with index
+    //! \brief at    Return message at index beginning from oldest one. index value must not exceed messages count (Common fixedContainer interface)
+    //! \param index index is value from 0 to count. When index eq 0 then return oldest message
+    //! \return      Message with index
     //!
-    Item &at( int index ) { return mBuffer[mTop + index]; }
+    Item &at( int index ) { return *mQueue.at(index); }
 
     //!
-    //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
+    //! \brief waitItem Waits until there is at least one message in the channel (Common fixedContainer interface)
     //!
-    void  waitItem() { smFixedWaitItem<SmFixedStackObject>( this ); }
+    void  waitItem() { smFixedWaitItem<SmFixedChannelObject>( this ); }
 
     //!
-    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //! \brief waitItemCount Waits until there is at least count messages in the channel (Common fixedContainer interface)
     //!
-    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedStackObject>( this, count ); }
+    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedChannelObject>( this, count ); }
 
     //!
-    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //! \brief waitEmpty Waits until there is at least one free block in the pool (Common fixedContainer interface)
     //!
-    void  waitEmpty() { smFixedWaitEmpty<SmFixedStackObject>( this ); }
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedChannelObject>( this ); }
 
     //!
-    //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
+    //! \brief waitEmptyCount Waits until there is at least count free blocks in the pool (Common fixedContainer interface)
     //!
-    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedStackObject>( this, count ); }
+    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedChannelObject>( this, count ); }
 
+#if SM_FIXED_EVENTS
     //!
-    //! \brief head Return top stack element
-    //! \return     Element at top of stack
+    //! \brief setEventFlags Sets event flags posted when message sent to the channel. Event flags for free blocks
+    //!                      are set for pool
+    //! \param event         Event flags or nullptr to stop posting
+    //! \param itemBits      Flags posted when message sent to the channel
     //!
-    Item &top() const { mBuffer[mTop]; }
+    void  setEventFlags( SmEventFlags *event, unsigned itemBits ) { mQueue.setEventFlags( event, itemBits ); }
+#endif
 
     //!
-    //! \brief pop Pop item from stack
-    //! \return    Item from top of stack
+    //! \brief allocate Allocates block for new message. If there is no free blocks then it wait until block will be released
+    //! \return         Pointer to message block owned by caller
     //!
-    Item pop() {
-      waitItem();
-      return mBuffer[mTop++];
-      }
+    Item *allocate() { return mPool.allocate(); }
 
     //!
-    //! \brief push Push item on to stack
-    //! \param item Pushed item
+    //! \brief send Sends message to the channel. After sending the block is owned by channel and must not be used by caller
+    //! \param item Pointer to message block
     //!
-    void  push( Item item ) {
-      waitEmpty();
-      mBuffer[--mTop] = item;
-      }
+    void  send( Item *item ) { mQueue.enque( item ); }
 
+    //!
+    //! \brief receive Receives message from the channel. If channel is empty then it wait until message will be sent
+    //! \return        Pointer to message block owned by caller. Caller must release it or send it to other channel
+    //!
+    Item *receive() { return mQueue.deque(); }
 
+    //!
+    //! \brief release Returns block of received message to the pool
+    //! \param item    Pointer to message block
+    //!
+    void  release( Item *item ) { mPool.release( item ); }
   };
 
 
 
 
 //!
-//! \brief The SmFixedBuffer class
+//! \brief The SmFixedHeap class Template class for priority queue with fixed size built on binary heap. Push and pop take
+//!                           O(log n) time. Top of heap is the greatest item according to comparator SmCompare, which
+//!                           is SmLess by default. Use SmGreater to get smallest item on top.
 //!
-template <class Item, int bufferSize>
-class SmFixedBuffer {
-    using SmFixedBufferObject = SmFixedBuffer<Item,bufferSize>;
+template <class Item, int heapSize, class SmCompare = SmLess<Item> >
+class SmFixedHeap : public SmEventPost {
+    using SmFixedHeapObject = SmFixedHeap<Item,heapSize,SmCompare>;
 
-    int  mCount;              //!< Element count
-    Item mBuffer[bufferSize]; //!< Element buffer
+    int       mCount;            //!< Item count
+    Item      mBuffer[heapSize]; //!< Heap buffer. Item at index i is not less than items at 2i+1 and 2i+2
+    SmCompare mCompare;          //!< Comparator object
   public:
-    SmFixedBuffer() : mCount(0) {}
-
-
+    SmFixedHeap() : mCount(0) {}
 
     //!
-    //! \brief itemCount Returns item count in the buffer (Common fixedContainer interface)
-    //! \return          Item count in the buffer
+    //! \brief itemCount Returns item count in the heap (Common fixedContainer interface)
+    //! \return          Item count in the heap
     //!
     int   itemCount() const { return mCount; }
 
     //!
-    //! \brief emptyCount Returns count of free places in the buffer (Common fixedContainer interface)
+    //! \brief emptyCount Returns count of free places in the heap (Common fixedContainer interface)
     //! \return           Count of free places
     //!
-    int   emptyCount() const { return bufferSize - mCount; }
+    int   emptyCount() const { return heapSize - mCount; }
 
     //!
-    //! \brief clear Clear buffer contents (Common fixedContainer interface)
+    //! \brief clear Clear heap contents (Common fixedContainer interface)
     //!
-    void  clear() { mCount = 0; }
+    void  clear() { mCount = 0; postEmpty(); }
 
     //!
-    //! \brief at    Return item at index beginning from begin of buffer. index value must not exceed elements count (Common fixedContainer interface)
-    //! \param index index is value from 0 to count. When index eq 0 then return first element
+    //! \brief at    Return item at index in heap order. index value must not exceed elements count (Common fixedContainer interface)
+    //! \param index index is value from 0 to count. When index eq 0 then return top element
     //! \return      Element with index
     //!
     Item &at( int index ) { return mBuffer[index]; }
@@ -1000,115 +3219,196 @@ class SmFixedBuffer {
     //!
     //! \brief waitItem Waits until there is at least one element in the container (Common fixedContainer interface)
     //!
-    void  waitItem() { smFixedWaitItem<SmFixedBufferObject>( this ); }
+    void  waitItem() { smFixedWaitItem<SmFixedHeapObject>( this ); }
 
     //!
-    //! \brief waitItem Waits until there is at least count elements in the container (Common fixedContainer interface)
+    //! \brief waitItemCount Waits until there is at least count elements in the container (Common fixedContainer interface)
     //!
-    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedBufferObject>( this, count ); }
+    void  waitItemCount( int count ) { smFixedWaitItemCount<SmFixedHeapObject>( this, count ); }
 
     //!
     //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
     //!
-    void  waitEmpty() { smFixedWaitEmpty<SmFixedBufferObject>( this ); }
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedHeapObject>( this ); }
 
     //!
     //! \brief waitEmptyCount Waits until there is space for at least count elements (Common fixedContainer interface)
     //!
-    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedBufferObject>( this, count ); }
+    void  waitEmptyCount( int count ) { smFixedWaitEmptyCount<SmFixedHeapObject>( this, count ); }
 
+    //!
+    //! \brief top Return top heap element. Heap must not be empty
+    //! \return    Greatest element according to comparator
+    //!
+    Item &top() { return mBuffer[0]; }
 
     //!
-    //! \brief append Append one item to end of buffer
-    //! \param item   Item to append
+    //! \brief push Puts an item in the heap
+    //! \param item Item to put
     //!
-    void  append( Item item ) {
-      //Wait for emty space for one item
+    void  push( Item item ) {
+      //Wait for empty space for one item
       waitEmpty();
-      //Place item
-      mBuffer[mCount++] = item;
+      //Sift up hole from the end of heap while parent less than item
+      int pos = mCount++;
+      while( pos > 0 ) {
+        int parent = (pos - 1) >> 1;
+        if( !mCompare( mBuffer[parent], item ) ) break;
+        mBuffer[pos] = mBuffer[parent];
+        pos = parent;
+        }
+      mBuffer[pos] = item;
+      postItem();
       }
 
     //!
-    //! \brief append Append block of count items to end of buffer
-    //! \param items  Pointer to block of items
-    //! \param count  Count of appended items
+    //! \brief pop Retrieves top item from the heap
+    //! \return    Retrieved item
     //!
-    void  append( Item *items, int count ) {
-      //Wait for emty space for count items
-      waitEmptyCount( count );
-      //Place items
-      while( count-- )
-        mBuffer[mCount++] = *items++;
+    Item  pop() {
+      waitItem();
+      Item item = mBuffer[0];
+      Item last = mBuffer[--mCount];
+      //Sift down hole from the top while greater child is greater than last item
+      int pos = 0;
+      int child;
+      while( (child = 2 * pos + 1) < mCount ) {
+        if( child + 1 < mCount && mCompare( mBuffer[child], mBuffer[child + 1] ) ) child++;
+        if( !mCompare( last, mBuffer[child] ) ) break;
+        mBuffer[pos] = mBuffer[child];
+        pos = child;
+        }
+      mBuffer[pos] = last;
+      postEmpty();
+      return item;
       }
+  };
+
+
+
+
+//!
+//! \brief The SmFixedBroadcast class Template class for passing each item from one writer to several readers. Ring has
+//!                               one write cursor and independent read cursor for each reader, so item is written
+//!                               once regardless of count of readers. When overwrite is false writer waits for
+//!                               slowest reader, otherwise oldest items are overwritten and lagging reader loses them.
+//!                               ringSize must be power of two
+//!
+template <class Item, int ringSize, int readerMax, bool overwrite = false>
+class SmFixedBroadcast : public SmEventPost {
+    using SmFixedBroadcastObject = SmFixedBroadcast<Item,ringSize,readerMax,overwrite>;
+    using SmFixedBroadcastReader = SmPointerAndValue<SmFixedBroadcastObject,int>;
+
+    static_assert( ringSize > 0 && (ringSize & (ringSize - 1)) == 0, "Ring size must be power of two" );
+
+    unsigned mWrite;                  //!< Count of written items. Index in ring is count modulo ringSize
+    unsigned mRead[readerMax];        //!< Count of items read by each reader
+    unsigned mLost[readerMax];        //!< Count of items overwritten before read by each reader
+    bool     mSubscribed[readerMax];  //!< Subscription flag of each reader
+    Item     mBuffer[ringSize];       //!< Item ring
+  public:
+    SmFixedBroadcast() : mWrite(0) { for( int i = 0; i < readerMax; i++ ) mSubscribed[i] = false; }
 
     //!
-    //! \brief insert Inserts one item in specified position of buffer
-    //! \param item   Inserted item
-    //! \param pos    Position to which item will be inserted
+    //! \brief subscribe Subscribes new reader. Reader receives items written after subscription
+    //! \return          Index of reader or -1 when there is no free place for reader
     //!
-    void  insert( Item item, int pos ) {
-      //Wait for emty space for one item
-      waitEmpty();
-      mCount++;
-      //Free space to item. We shift all right-stand items to one position to right
-      for( int i = mCount - 1; i > pos; i-- )
-        mBuffer[i] = mBuffer[i - 1];
-      //Place item
-      mBuffer[pos] = item;
+    int   subscribe() {
+      for( int i = 0; i < readerMax; i++ )
+        if( !mSubscribed[i] ) {
+          mSubscribed[i] = true;
+          mRead[i] = mWrite;
+          mLost[i] = 0;
+          return i;
+          }
+      return -1;
       }
 
     //!
-    //! \brief insert Inserts block of count items in specified position of buffer
-    //! \param items  Inserted item block
-    //! \param pos    Position to which item block will be inserted
-    //! \param count  Count of inserted items
+    //! \brief unsubscribe Removes reader, so writer does not wait for it
+    //! \param reader      Index of reader
     //!
-    void  insert( Item *items, int pos, int count ) {
-      //Wait for emty space for count items
-      waitEmptyCount(count);
-      mCount += count;
-      //Free space to item block. We shift all right-stand items to count positions to right
-      for( int i = mCount - 1; i > pos; i-- )
-        mBuffer[i] = mBuffer[i - 1];
-      //Place items
-      while( count-- )
-        mBuffer[pos++] = *items++;
+    void  unsubscribe( int reader ) { mSubscribed[reader] = false; postEmpty(); }
+
+    //!
+    //! \brief itemCount Returns count of items not read by slowest reader (Common fixedContainer interface)
+    //! \return          Item count in the ring
+    //!
+    int   itemCount() const {
+      unsigned count = 0;
+      for( int i = 0; i < readerMax; i++ )
+        if( mSubscribed[i] && mWrite - mRead[i] > count )
+          count = mWrite - mRead[i];
+      return count > static_cast<unsigned>(ringSize) ? ringSize : static_cast<int>(count);
       }
 
     //!
-    //! \brief remove Removes one item from specified position of buffer
-    //! \param pos    Position of removed item
+    //! \brief emptyCount Returns count of items which may be written without waiting (Common fixedContainer interface)
+    //! \return           Count of free places
     //!
-    void  remove( int pos ) {
-      waitItem();
-      for( pos++; pos < mCount; pos++ )
-        mBuffer[pos - 1] = mBuffer[pos];
-      mCount--;
+    int   emptyCount() const { return overwrite ? ringSize : ringSize - itemCount(); }
+
+    //!
+    //! \brief itemCount Returns count of items not read by reader
+    //! \param reader    Index of reader
+    //! \return          Item count for reader
+    //!
+    int   itemCount( int reader ) const {
+      unsigned count = mWrite - mRead[reader];
+      return count > static_cast<unsigned>(ringSize) ? ringSize : static_cast<int>(count);
       }
 
     //!
-    //! \brief remove Removes block of items begining from specified position of buffer
-    //! \param pos    Position of removed item block
-    //! \param count  Count of removed items
+    //! \brief lostCount Returns count of items overwritten before reader read them
+    //! \param reader    Index of reader
+    //! \return          Count of lost items
     //!
-    void  remove( int pos, int count ) {
-      waitItemCount( count );
-      for( pos += count; pos < mCount; pos++ )
-        mBuffer[pos - count] = mBuffer[pos];
-      mCount -= count;
+    unsigned lostCount( int reader ) const { return mLost[reader]; }
+
+    //!
+    //! \brief waitItem Waits until there is at least one item for reader
+    //! \param reader   Index of reader
+    //!
+    void  waitItem( int reader ) {
+      if( mWrite == mRead[reader] ) {
+        SmFixedBroadcastReader waiter( this, reader );
+        smWait<SmFixedBroadcastReader>( &waiter, [] ( SmFixedBroadcastReader *r ) -> bool { return r->mPointer->mWrite != r->mPointer->mRead[r->mValue]; } );
+        }
       }
 
+    //!
+    //! \brief waitEmpty Waits until there is space for at least one element (Common fixedContainer interface)
+    //!
+    void  waitEmpty() { smFixedWaitEmpty<SmFixedBroadcastObject>( this ); }
 
     //!
-    //! \brief receiv Receiv single item into buffer. Item placed into buffer if there is anough space in them
-    //! \param item   Received item
+    //! \brief write Writes item to the ring for all readers. Without overwrite it waits for slowest reader
+    //! \param item  Item to write
     //!
-    void receiv( Item item ) {
-      if( emptyCount() )
-        mBuffer[mCount++] = item;
+    void  write( const Item &item ) {
+      if( !overwrite ) waitEmpty();
+      mBuffer[mWrite & (ringSize - 1)] = item;
+      mWrite++;
+      postItem();
       }
 
+    //!
+    //! \brief read   Reads next item for reader. If there is no items then it wait until item will be written
+    //! \param reader Index of reader
+    //! \return       Read item
+    //!
+    Item  read( int reader ) {
+      waitItem( reader );
+      //Skip overwritten items
+      if( overwrite && mWrite - mRead[reader] > static_cast<unsigned>(ringSize) ) {
+        mLost[reader] += mWrite - mRead[reader] - ringSize;
+        mRead[reader]  = mWrite - ringSize;
+        }
+      Item item = mBuffer[mRead[reader] & (ringSize - 1)];
+      mRead[reader]++;
+      if( !overwrite ) postEmpty();
+      return item;
+      }
   };
 
 
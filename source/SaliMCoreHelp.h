@@ -58,13 +58,25 @@
 
    - \ref cpart
       - system tick count \ref smTickCount
+      - 64-bit time \ref smTickIsr, \ref smTickCount64, \ref smTimeUs
       - SaliMLib init \ref smInit
+      - \ref formatFunctions
+         - \ref smFormatInt, \ref smFormatUInt, \ref smFormatHex, \ref smFormatFixed, \ref smFormatHexDump
+         - \ref smAppendInt, \ref smAppendUInt, \ref smAppendHex, \ref smAppendFixed, \ref smAppendHexDump
    - C++ interface
       - \ref taskFunctions
          - task creation function \ref smTaskCreate
          - task creation template \ref smTaskCreateClass
+         - task control block \ref SmTaskBlock
+         - task stack \ref SmTaskStack
+         - deadline of task \ref smTaskSetDeadline, \ref smTaskSetDeadlineAt
+         - periodic task \ref smTaskCreatePeriodic, \ref SmTaskPeriodic
+         - task handles \ref smTaskCurrent, \ref smTaskFirst, \ref smTaskNext, \ref smTaskSuspend, \ref smTaskResume,
+           \ref smTaskTerminate
       - \ref waitFunctions
          - \ref smWaitVoid
+         - \ref smWaitSignal
+         - \ref smWaitVoidUntil
          - \ref smWait
          - \ref smWaitClass
          - \ref smWaitClassPtr
@@ -73,23 +85,67 @@
          - \ref smWaitIntUntilZero
          - \ref smWaitIntUntilNotZero
          - \ref smWaitTick
+         - \ref smWaitUs
+         - \ref smWaitUsUntil
+         - \ref smWaitAndUs
          - \ref smYeld
+         - \ref smYieldTo
       - \ref tickFunctions
          - \ref smTickFuture
          - \ref smTickIsOut
+         - \ref smTimeFutureUs
+         - \ref smTimeIsOutUs
+      - \ref wakeHistogram
+         - \ref smWakeHistogramDump
+         - \ref smWakeHistogram
+         - \ref smWakeHistogramClear
+      - \ref hogDetector
+         - \ref smHogBudget
+         - \ref smHogMaxSlice
+         - \ref smHogClear
       - resource access guarding
          - \ref mutex
            - \ref SmMutex
            - \ref SmMutexLocker
+           - \ref SmMutexFifo
+           - \ref SmMutexFifoLocker
+           - \ref SmRwLock
+           - \ref SmRwLockReadLocker
+           - \ref SmRwLockWriteLocker
          - \ref semaphor
            - \ref SmSemaphor
            - \ref SmSemaphorLocker
+           - \ref SmSemaphorFifo
+           - \ref SmSemaphorFifoLocker
+      - \ref eventFlags
+         - \ref SmEventFlags
+         - \ref SmIrqLocker
       - \ref fixedContainers
          - \ref SmFixedQueue
          - \ref SmFixedStack
          - \ref SmFixedBuffer
+         - \ref SmFixedSortedMap
+         - \ref SmFixedSortedSet
+         - \ref SmFixedHashMap
+         - \ref SmFixedPool
+         - \ref SmFixedChannel
+         - \ref SmFixedHeap
+         - \ref SmFixedBroadcast
       - \ref containerAlgorithms
          - \ref SmContainerItemWaiter
+      - \ref timers
+         - \ref SmTimer
+         - \ref smTimerTask
+         - \ref smTimerService
+      - \ref shell
+         - \ref SmShell
+         - \ref SmShellCommand
+         - \ref SM_SHELL_CHECK
+      - \ref log
+         - \ref smLog
+         - \ref smLogTask
+         - \ref smLogTake
+         - \ref smLogFormat
 
    */
 
@@ -242,6 +298,23 @@ void SysTick_Handler(void)
   }
 \endcode
 
+32-bit smTickCount wraps after 49 days with 1 ms tick. When 64-bit time is required, call smTickIsr
+instead of increment. In addition to increment it extends tick count to 64 bits and captures hardware cycle
+counter (DWT on Cortex-M3/M4/M7, SysTick on Cortex-M0), so smTimeUs returns microseconds with sub-tick
+resolution. Tick period in microseconds is defined by SM_TICK_US macro (1000 by default).
+\code
+void SysTick_Handler(void)
+  {
+  smTickIsr(); // Increment of the system tick counter with 64-bit extension
+  HAL_IncTick();
+  }
+
+  ...
+  int64_t start = smTimeUs();
+  doSomething();
+  int64_t duration = smTimeUs() - start;
+\endcode
+
 
 For example main function
 \code
@@ -440,6 +513,72 @@ void f()
 
 
 
+/*! \addtogroup wakeHistogram SaliMLib Wake-latency histograms
+
+In cooperative multitasking task resumes only when all tasks before it in the loop release processor, so task
+resumes later than requested moment or later than event occured. To measure this latency define global macro
+SM_WAKE_HISTOGRAM to 1 and use smTickIsr as tick handler. Then each task collects two histograms: deadline histogram
+for timed waits (smWaitTick, smWaitTickUntil, smWaitUs, time out of smWaitAndFuture family and SmEventFlags) and
+signal histogram for SmEventFlags waits. Recording takes reading of time and one increment per wakeup.
+
+\code
+void uartPutChar( char ch ) { ... }
+
+void statisticTask( void* )
+  {
+  while(true) {
+    smWaitTick( 10000 );
+    //Prints for example "task 1 deadline 0:1200 1:300 2:41 64:2"
+    smWakeHistogramDump( uartPutChar );
+    smWakeHistogramClear();
+    }
+  }
+\endcode
+
+On host counts may be read with smWakeHistogram function. Histograms are available only with native scheduler,
+with FreeRTOS and POSIX backends SM_WAKE_HISTOGRAM causes compile error.
+ */
+
+
+
+
+
+
+
+
+
+/*! \addtogroup hogDetector SaliMLib Hog detector
+
+Single task which forgets to call smYeld or any wait function in long loop stalls all other tasks. With global macro
+SM_HOG_DETECTOR defined as 1 kernel takes time stamp when task resumes and measures run slice when task calls wait
+function. Longest slice of each task is held and may be read with smHogMaxSlice. When slice exceeds budget set by
+smHogBudget, callback function is called in context of guilty task, so it may be logged even in production builds.
+Detector is available only with native scheduler, with FreeRTOS and POSIX backends SM_HOG_DETECTOR causes compile
+error.
+
+\code
+void hogReport( int task, unsigned sliceUs )
+  {
+  logPrint( "task %d run %u us\n", task, sliceUs );
+  }
+
+void main(void)
+  {
+  smInit(100);
+  smHogBudget( 500, hogReport );
+  ...
+  }
+\endcode
+ */
+
+
+
+
+
+
+
+
+
 /*! \addtogroup taskFunctions SaliMLib functions for task creation
 
 Tasks are quasi-parallel functions. "Quasi" means that since the processor has one core,
@@ -508,6 +647,109 @@ the type itself, since the template does this consistently, which ultimately red
 
 The issue of passing multiple parameters is solved by passing a pointer to a structure where multiple
 parameters can be described.
+
+Task control blocks of smTaskCreate are taken from internal pool of SM_TASK_MAX blocks (16 by default). The pool
+costs memory for every block whether it used or not and limits count of tasks. Task block may be provided by
+caller, for example as member of object which owns task. Then count of tasks is limited only by memory and
+SM_TASK_MAX may be reduced even to 0. When task function returns, block becomes free and may be used again.
+
+\code
+struct Connection {
+    SmTaskBlock mTask;
+    int         mSocket;
+  };
+
+Connection connections[1000];
+
+void connectionTask( Connection *con ) { ... }
+
+  for( int i = 0; i < 1000; i++ )
+    smTaskCreate( &connections[i].mTask, 200, connections + i, (SmTaskFunction)connectionTask );
+\endcode
+
+By default stacks of all tasks are taken from main stack below stack of main loop task, so main stack size
+must account for every task. Task with caller-provided block may use caller-provided stack too. SmTaskStack
+template sizes and aligns stack memory, so it may be placed to any memory section, for example latency-critical
+task may use fast core-coupled memory.
+
+\code
+static SmTaskBlock       motorTask;
+static SmTaskStack<200>  motorStack __attribute__((section(".ccmram")));
+
+  smTaskCreate( &motorTask, motorStack, nullptr, motorControl, true );
+\endcode
+
+Critic tasks are scanned before all other tasks and by default first ready critic task in task ring runs. So
+task with imminent deadline may wait behind task with plenty of slack. When global macro SM_EDF is defined as 1,
+scheduler runs ready critic task with earliest absolute deadline. Task declares relative deadline with
+smTaskSetDeadline, then on each wait its deadline is moment when scheduler first finds it ready plus relative
+deadline, or passes absolute deadline for next wait with smTaskSetDeadlineAt. So task which waited long for sporadic
+event does not outrun task with imminent deadline. Tasks without deadline are later than any task with it.
+
+\code
+void sampleTask( void* )
+  {
+  int release = smTickCount;
+  while(true) {
+    release += 10;
+    //Sample must be processed in 2 ticks after release
+    smTaskSetDeadlineAt( release + 2 );
+    smWaitTickUntil( release );
+    processSample();
+    }
+  }
+\endcode
+
+Periodic loop written as work() followed by smWaitTick(period) drifts by execution time of work on every cycle.
+smTaskCreatePeriodic creates task which calls job function once per period with releases locked to absolute ticks.
+SmTaskPeriodic object holds task block and statistics: count of jobs, count of overruns (job completed after
+next release) and jitter of job start after release in microseconds. All periodic tasks are released by scheduler
+from one list sorted by release moment, so there is no time predicate per task.
+
+\code
+SmTaskPeriodic adcTask;
+
+void adcJob( void* )
+  {
+  startConversion();
+  }
+
+  //Every 10 ticks with first release in 3 ticks
+  smTaskCreatePeriodic( &adcTask, 200, 10, 3, adcJob );
+  ...
+  if( adcTask.overrunCount() ) ...
+\endcode
+
+smTaskCreate returns handle of created task. Handle is used to suspend, resume and terminate task.
+Suspended task is excluded from task ring, so scheduler does not test its wait function at all, unlike task
+parked on flag which is tested at every switch. Task may suspend itself, then it continues after smTaskResume
+called by other task. Resumed task continues its wait. Terminated task block becomes free and may be reused
+for new task. Main loop task can not be suspended or terminated. Terminated periodic task is removed from release
+list, so its object may be used for new periodic task. Suspended tasks are not visited by walk of task ring,
+smTaskFirst and smTaskNext enumerate all tasks including suspended ones, so shell command tasks, hog statistics
+and wake-latency histograms cover suspended tasks too.
+RTOS and POSIX schedulers do not support task handles: smTaskCreate returns nullptr, periodic tasks and functions
+smTaskCurrent, smTaskFirst, smTaskNext, smTaskSuspend, smTaskResume and smTaskTerminate are not available. They
+accept caller-provided task blocks and stacks, but allocate task and its stack themselves.
+
+\code
+SmTaskHandle logTask;
+
+  logTask = smTaskCreate( 200, nullptr, logLoop );
+  ...
+  //Logging is not needed while motor runs
+  smTaskSuspend( logTask );
+  runMotor();
+  smTaskResume( logTask );
+\endcode
+
+In producer and consumer pair producer may pass control directly to consumer with smYieldTo. When consumer
+is ready, scheduler switches to it without scan of task ring, so handoff costs only context switch.
+
+\code
+  queue.enque( sample );
+  smYieldTo( consumerTask );
+\endcode
     */
 
 
@@ -565,7 +807,32 @@ As soon as the waitFunction function returns true, the task gets control.
 When calling smWaitVoid, the system will try to transfer control to another task anyway. If there are no tasks
 ready for execution and the wait Function returns true, control returns to the current task.
 
-\sa smWaitVoid
+Native scheduler tests wait functions on every task switch. When SaliMLib works over FreeRTOS (SaliMCoreRTOS.h),
+waiting task blocks on task notification and tests its wait function only when smWaitSignal called or when
+its deadline comes, so waiting tasks do not consume processor and idle task (and tickless idle) may run. Mutexes,
+semaphors, event flags and fixed containers call smWaitSignal themselves. Timed waits (smWaitTickUntil,
+smWaitAndFuture, SmEventFlags::waitAnyAndFuture and others) pass their deadline to smWaitVoidUntil. If custom wait
+function tests own variable, call smWaitSignal after its change to resume waiting task. If custom wait function tests
+time, wait with smWaitUntil and pass the deadline. Wait functions which test hardware registers can not be signaled:
+for them define poll period SM_RTOS_POLL_MS in milliseconds (0 by default, which means no polling).
+
+SaliMCorePosix.h runs the same application code as normal Linux process: each task is posix thread, but only one of
+them runs at the same time, in round robin order of native scheduler. smTickCount counts milliseconds of
+CLOCK_MONOTONIC and waiting task blocks on condition variable. Threads which are not tasks play role of interrupts:
+they may change primitives guarded by SmIrqLocker, for example SmEventFlags::set, or call smWaitSignal after
+changing of own variables.
+
+\code
+bool ready;
+
+void isrHandler()
+  {
+  ready = true;
+  smWaitSignal();
+  }
+\endcode
+
+\sa smWaitVoid, smWaitVoidUntil, smWaitSignal
     */
 
 
@@ -685,6 +952,70 @@ void f()
 
 
 
+/*! \class SmMutexFifo
+
+SmMutex waits for its boolean variable becomes false. When it unlocked, wait functions of all waiting tasks become
+true at once and resource gets the task which scheduler meets first, while other tasks continue waiting. Under
+contention order of access is unfair and waiting time is not bounded.
+
+SmMutexFifo works as ticket lock. Each task which locks resource takes a ticket, and resource is handed to tickets
+strictly in order. On unlock only wait function of the oldest waiting task becomes true, so there are no idle
+wakeups and waiting time is bounded by the work of tasks which came earlier.
+
+\code
+SmMutexFifo spi3Mutex;
+
+void f()
+  {
+  SmMutexFifoLocker locker(spi3Mutex);
+
+  //Do something
+  }
+\endcode
+
+\sa SmMutex, SmSemaphorFifo
+  */
+
+
+
+
+
+
+
+/*! \class SmRwLock
+
+Configuration and calibration tables are read by almost every task but written rarely. Guarding them with SmMutex
+serializes readers which never conflict. SmRwLock allows any number of readers to hold resource at once, while
+writer holds it exclusively. By default lock prefers writers: when writer waits, new readers wait too, so stream
+of readers can not starve updates. Pass false to constructor to disable writer preference.
+
+\code
+SmRwLock calibrationLock;
+int      calibration[16];
+
+int readCalibration( int index )
+  {
+  SmRwLockReadLocker locker(calibrationLock);
+  return calibration[index];
+  }
+
+void writeCalibration( const int *table )
+  {
+  SmRwLockWriteLocker locker(calibrationLock);
+  for( int i = 0; i < 16; i++ )
+    calibration[i] = table[i];
+  }
+\endcode
+
+\sa SmMutex
+  */
+
+
+
+
+
+
+
 /*! \addtogroup semaphor SaliMLib Semaphor
 
 Some resources have multiple but limited access. In this case, semaphores are usually used, which work
@@ -792,6 +1123,61 @@ void f()
 
 
 
+/*! \addtogroup eventFlags SaliMLib Event flags
+
+Waiting for one of several events, for example "queue A has data OR queue B has data OR timeout", may be written with
+custom structure and wait function, but such wait function checks every source on every scan of tasks. SmEventFlags
+holds up to 32 flags in one word, so waiting for any or all of them costs one comparison independently of count of
+sources. Flags may be set and cleared from tasks and from interrupts. Wait functions return flags which fired and by
+default clear them.
+
+When global macro SM_FIXED_EVENTS is defined as 1, fixed containers may post flags on their state changes. Item flags
+are set when item appended to container and empty flags when item removed from container.
+
+\code
+SmEventFlags uartEvents;
+
+SmFixedQueue<char,100> rxQueue;
+SmFixedQueue<char,100> cmdQueue;
+
+#define EV_RX     0x1
+#define EV_CMD    0x2
+#define EV_BREAK  0x4
+
+void UART_IRQHandler()
+  {
+  if( isBreak() )
+    uartEvents.set( EV_BREAK );
+  ...
+  }
+
+void protocolTask( void* )
+  {
+  rxQueue.setEventFlags( &uartEvents, EV_RX );
+  cmdQueue.setEventFlags( &uartEvents, EV_CMD );
+  while(true) {
+    unsigned ev = uartEvents.waitAnyAndTick( EV_RX | EV_CMD | EV_BREAK, 1000 );
+    if( ev == 0 ) {
+      //Time out
+      }
+    if( ev & EV_RX ) {
+      ...
+      }
+    ...
+    }
+  }
+\endcode
+
+Setting and clearing of flags are guarded against interrupts with SmIrqLocker, which uses platform-dependent functions
+smPortIrqDisable and smPortIrqRestore.
+    */
+
+
+
+
+
+
+
 /*! \addtogroup fixedContainers SaliMLib Containers with fixed size
 
 For embedded systems, they often try to exclude the use of the heap. This is due to the unpredictable behavior
@@ -854,6 +1240,420 @@ to avoid switching tasks built into these functions.
 
 
 
+/*! \class SmFixedPool
+
+  SaliMLib does not use dynamic memory allocation, but some objects, for example packets, have variable lifetime.
+Such objects may be allocated from pool of fixed size blocks. Allocation and release take constant time and pool
+never fragments. Like other fixed containers the pool has built-in waiting: allocate waits until block is released
+by other task. tryAllocate returns nullptr instead of waiting.
+
+\code
+struct Packet {
+  int     mSize;
+  uint8_t mData[256];
+  };
+
+//Pool of 8 packets with statistics
+SmFixedPool<Packet,8,true> packetPool;
+
+void receiverTask( void* )
+  {
+  while(true) {
+    //Allocate packet. If all packets are in use then wait until one will be released
+    Packet *packet = packetPool.allocate();
+    //Fill and process packet
+    ...
+    //Return packet to pool
+    packetPool.release( packet );
+    }
+  }
+\endcode
+
+When third template parameter is true the pool counts maximum of simultaneously allocated blocks (highWater) and
+count of allocation requests found pool empty (failCount). By default statistics is disabled and costs nothing.
+
+\warning Important! Pool is not protected against interrupts. When used in interrupts, use only tryAllocate and
+release and guard pool access in tasks.
+  */
+
+
+
+
+
+
+
+/*! \class SmFixedChannel
+
+  Passing big items through SmFixedQueue copies the whole item on enque and again on deque. SmFixedChannel
+passes only pointers to blocks allocated from SmFixedPool, so the cost of passing a message does not depend on
+its size. The block is owned by the producer after allocate, by the channel after send and by the consumer after
+receive. The consumer returns block to the pool with release or passes it further with send of other channel
+built on the same pool.
+
+\code
+struct Packet {
+  int     mSize;
+  uint8_t mData[256];
+  };
+
+using PacketPool    = SmFixedPool<Packet,16>;
+using PacketChannel = SmFixedChannel<Packet,16>;
+
+PacketPool    packetPool;
+PacketChannel rxChannel( packetPool );
+PacketChannel txChannel( packetPool );
+
+void routerTask( void* )
+  {
+  while(true) {
+    //Wait for received packet
+    Packet *packet = rxChannel.receive();
+    //Route packet without copying
+    if( isForUs(packet) ) {
+      process( packet );
+      rxChannel.release( packet );
+      }
+    else txChannel.send( packet );
+    }
+  }
+\endcode
+
+\sa SmFixedPool
+  */
+
+
+
+
+
+
+
+/*! \class SmFixedHeap
+
+  SmFixedHeap is a priority queue with fixed size. Items are extracted in order of priority defined by comparator
+which is passed as third template parameter. With default comparator SmLess the greatest item is extracted first,
+with SmGreater the smallest one. Push and pop take O(log n) time instead of linear search over SmFixedBuffer.
+Like other fixed containers push waits for free space and pop waits for items.
+
+\code
+struct RadioPacket {
+  int mDeadline; //Moment from smTickFuture when packet must be sent
+  ...
+  };
+
+//Most urgent packet has earliest deadline. smTickIsOut-style comparison is wrap-safe
+struct RadioPacketUrgency {
+  bool operator () ( const RadioPacket &p1, const RadioPacket &p2 ) const { return p1.mDeadline - p2.mDeadline > 0; }
+  };
+
+SmFixedHeap<RadioPacket,32,RadioPacketUrgency> radioHeap;
+
+void radioTask( void* )
+  {
+  while(true) {
+    //Wait for packet and take most urgent one
+    RadioPacket packet = radioHeap.pop();
+    send( packet );
+    }
+  }
+\endcode
+
+\sa SmLess, SmGreater
+  */
+
+
+
+
+
+
+
+/*! \class SmFixedSortedMap
+
+  Lookup tables such as register maps or routing tables kept in SmFixedBuffer are searched by linear scan.
+SmFixedSortedMap holds entries in SmFixedBuffer sorted by key, so find takes O(log n) by binary search. Insert
+finds position with lowerBound and shifts following entries, so tables which are filled once and searched often
+are suitable. Like other fixed containers insert waits for free space when map is full. SmFixedSortedSet is the
+same container for keys without values.
+
+\code
+//Modbus register map
+SmFixedSortedMap<uint16_t,int16_t*,512> registerMap;
+
+  registerMap.insert( 40001, &motorSpeed );
+  registerMap.insert( 40002, &motorCurrent );
+  ...
+  int16_t **reg = registerMap.find( address );
+  if( reg == nullptr ) replyError( ILLEGAL_ADDRESS );
+\endcode
+
+\sa SmFixedSortedSet, SmFixedBuffer
+  */
+
+
+
+
+
+
+
+/*! \class SmFixedHashMap
+
+  SmFixedHashMap is a hash map with fixed size and without dynamic memory. Entry is placed in table at position
+defined by hash of key, and on collision at next free position (linear probing). Find, insert and remove take
+constant time in average while table is not nearly full. Remove shifts back following entries of probe chain
+instead of marking entry as deleted, so lookups do not degrade after many removes. Table size must be power of
+two and map holds up to size - 1 entries. Default hash function SmHash is suitable for integer keys, for other
+keys hash function is passed as fourth template parameter. Like other fixed containers insert waits for free
+space when map is full.
+
+\code
+struct Session {
+  int mLastTick;
+  int mPacketCount;
+  };
+
+//Sessions by node address
+SmFixedHashMap<uint32_t,Session,64> sessions;
+
+void onPacket( uint32_t node )
+  {
+  Session *session = sessions.find( node );
+  if( session == nullptr ) {
+    sessions.insert( node, Session{ smTickCount, 0 } );
+    session = sessions.find( node );
+    }
+  session->mPacketCount++;
+  }
+\endcode
+
+\sa SmHash, SmFixedSortedMap
+  */
+
+
+
+
+
+
+
+/*! \class SmFixedBroadcast
+
+  When one task produces items for several consumers, each consumer needs its own SmFixedQueue and every item is
+copied into each queue. SmFixedBroadcast holds one ring of items with one write cursor and independent read cursor
+for each reader, so item is written once regardless of count of readers. Each reader subscribes and reads with
+its index. By default writer waits when slowest reader lags by whole ring. With overwrite template parameter true
+writer never waits and lagging reader skips overwritten items, which are counted by lostCount.
+
+\code
+//Ring of 64 samples for up to 4 readers
+SmFixedBroadcast<int,64,4> adcRing;
+
+void adcTask( void* )
+  {
+  while(true) {
+    smWaitTick( 1 );
+    adcRing.write( readAdc() );
+    }
+  }
+
+void filterTask( void* )
+  {
+  int reader = adcRing.subscribe();
+  while(true)
+    filter( adcRing.read( reader ) );
+  }
+\endcode
+
+\sa SmFixedQueue
+  */
+
+
+
+
+
+
+
 /*! \addtogroup containerAlgorithms SaliMLib Algorithms for fixed-size containers
 
     */
+
+
+
+
+
+
+/*! \addtogroup timers SaliMLib Software timers
+
+Periodic or one-shot actions which are too short to have own task may be done by software timers. All timers
+are driven by one service task smTimerTask, so timers cost neither stack nor scan time of scheduler. Timer
+service is placed in separate files SaliMTimer.h and SaliMTimer.cpp which must be added to project.
+
+Timers are kept in hierarchical timing wheel keyed on smTickCount. Arming, cancelling and firing of timer take
+constant time independently of count of timers. Size of wheel is defined by macros SM_TIMER_WHEEL_BITS (bits of
+tick per level, 6 by default) and SM_TIMER_WHEEL_LEVELS (count of levels, 4 by default). Timer object is allocated
+by caller, usually as global or member variable.
+
+\code
+#include "SaliMTimer.h"
+
+void ledToggle( void* )
+  {
+  LedToggle();
+  }
+
+//Timer which toggles led
+SmTimer ledTimer( ledToggle );
+
+void main(void)
+  {
+  smInit(100);
+  //Create timer service task
+  smTaskCreate( 200, nullptr, smTimerTask );
+  //Toggle led every 300 ticks
+  ledTimer.start( 300, 300 );
+  ...
+  }
+\endcode
+
+Callbacks are called from the timer service task. Callback should be short and should not call wait functions,
+because it delays all other timers.
+    */
+
+
+
+
+
+
+
+/*! \addtogroup shell SaliMLib Command line shell
+
+Debug and maintenance console reads line of chars and compares first word with each command. SmShell reads line
+from queue of received chars, splits it to arguments in place without copying and finds command by hash of first
+word. Hashes of command names are calculated at compile time by constexpr function smShellHash, SM_SHELL_CHECK
+checks at compile time that all names of table have different hashes, that no name collides by hash with built-in
+command of other name and that table with built-in commands fits to index. Index from hash to command is SmFixedHashMap
+built when shell constructed, so lookup takes constant time independently of count of commands. Shell is placed
+in separate files SaliMShell.h and SaliMShell.cpp which must be added to project.
+
+Shell has built-in commands: help (list of commands), tasks (list of tasks of task ring with stack size and longest
+run slice when SM_HOG_DETECTOR enabled), uptime, version and wake (wake-latency histograms when SM_WAKE_HISTOGRAM
+enabled). User command with the same name replaces built-in one. Size of line, count of arguments and size of index
+are defined by macros SM_SHELL_LINE_SIZE (80 by default), SM_SHELL_ARG_MAX (8 by default) and SM_SHELL_INDEX_SIZE
+(64 by default, power of two greater than count of all commands).
+
+\code
+#include "SaliMShell.h"
+
+void cmdSpeed( SmShell &shell, int argc, char *argv[] )
+  {
+  if( argc > 1 ) motorSpeed = atoi( argv[1] );
+  shell.printInt( motorSpeed );
+  shell.print( "\n" );
+  }
+
+constexpr SmShellCommand commands[] = {
+  { "speed", cmdSpeed, "speed [value] - get or set motor speed" },
+  { "reset", cmdReset, "reset controller" },
+  };
+
+SM_SHELL_CHECK( commands );
+
+SmFixedQueue<char,64> uartRx; //Filled by uart interrupt
+SmShell shell( commands, uartPutChar );
+
+void shellTask( void* )
+  {
+  while(true)
+    shell.service( uartRx );
+  }
+\endcode
+
+Command function must be plain function, because in C++11 lambda can not be used in constexpr table.
+    */
+
+
+
+
+
+
+
+/*! \addtogroup log SaliMLib Deferred binary logging
+
+Formatting of printf-like message takes hundreds of microseconds, which is too long for time-critical task or
+interrupt. smLog does not format message: it stores pointer to format string, smTickCount and raw arguments into
+fixed ring of records. Records are formatted later by log task smLogTask, or taken raw by smLogTake, transferred
+to host and formatted there. Address of format string identifies record, so host decoder finds format string in
+firmware image by address. When ring is full new records are lost and counted by smLogLost, log call never waits.
+Record becomes visible to smLogTake only when it is completely filled, so log may be called from interrupts and
+from tasks of preemptive backends, and each record signals waiting log task.
+Logging is placed in separate files SaliMLog.h and SaliMLog.cpp which must be added to project.
+
+Size of ring and maximum count of arguments are defined by macros SM_LOG_SIZE (64 by default, power of two) and
+SM_LOG_ARG_MAX (4 by default). Format string and string arguments must remain valid until record formatted,
+usually they are literals.
+
+\code
+#include "SaliMLog.h"
+
+void motorTask( void* )
+  {
+  while(true) {
+    ...
+    if( current > currentLimit )
+      smLog( "overcurrent %d mA at speed %d", current, speed );
+    }
+  }
+
+void main(void)
+  {
+  smInit(100);
+  //Log task formats records to uart
+  smTaskCreate( 200, reinterpret_cast<void*>(uartPutChar), smLogTask );
+  ...
+  }
+\endcode
+
+Output line contains tick of record in brackets, for example "[12034] overcurrent 3100 mA at speed 1500".
+    */
+
+
+
+
+
+
+
+/*! \addtogroup formatFunctions
+
+Formatting with sprintf costs hundreds of cycles per number, because format string is parsed at run time and
+digits are produced one division at a time. Formatters of SaliMUtils produce fixed kinds of text directly: decimal
+digits are taken in pairs from 100-entry table, hex digits from 16-entry table with the same chars as
+smDigitToHexLow. They do not allocate memory and do not use libc. On host they are 4-15 times faster than snprintf
+with equivalent format, hexdump line is formatted about 15 times faster.
+
+C functions smFormatUInt, smFormatInt, smFormatHex, smFormatFixed and smFormatHexDump write text with terminating
+zero to char array and return its length. Sizes of arrays are defined by SM_FORMAT_..._SIZE macros.
+C++ templates smAppendUInt, smAppendInt, smAppendHex, smAppendFixed and smAppendHexDump append text directly to
+char container: SmFixedQueue<char,N> (item by item with enque) or SmFixedBuffer<char,N> (block with append).
+If container has not enough space then they wait as enque and append do.
+
+\code
+#include "SaliMUtils.h"
+
+SmFixedQueue<char,256> uartTx; //Emptied by uart interrupt
+
+void telemetryTask( void* )
+  {
+  while(true) {
+    //Line like "23.45 -120 0c1f"
+    smAppendFixed( uartTx, temperature, 2 );
+    uartTx.enque( ' ' );
+    smAppendInt( uartTx, current );
+    uartTx.enque( ' ' );
+    smAppendHex( uartTx, status, 4 );
+    uartTx.enque( '\n' );
+    //Dump of received frame
+    smAppendHexDump( uartTx, 0, frame, frameSize );
+    smWaitTick( 1000 );
+    }
+  }
+\endcode
+
+Hexdump line looks like "00000010: 48 65 6c 6c 6f 00 77 6f 72 6c 64 2c 20 64 75 6d |Hello.world, dum|".
+    */
@@ -0,0 +1,396 @@
+#include "SaliMCorePosix.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <limits.h>
+#include <stdint.h>
+
+static pthread_mutex_t smMutex = PTHREAD_MUTEX_INITIALIZER; //Guard of all following variables
+static pthread_cond_t  smTurnCond;                           //Signaled when turn passed
+static pthread_cond_t  smChangeCond;                         //Signaled when any task may change state
+static unsigned        smTicket;                             //Next ticket for turn
+static unsigned        smServing;                            //Ticket which holds turn
+static unsigned        smChange;                             //Generation of state changes
+static pthread_t       smOwner;                              //Thread which holds turn
+static int             smDepth;                              //Depth of turn acquiring by owner thread
+static struct timespec smStart;                              //Moment of smInit
+
+
+
+//Internal structure to pass task params to thread
+struct SmPosixTask {
+    void          *mArg;
+    SmTaskFunction mTaskFunction;
+    unsigned       mTicket;      //Ticket for first turn taken at creation, so task is ready as soon as created
+  };
+
+
+
+static int64_t smPosixNs( const struct timespec &ts )
+  {
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+
+
+
+//Waits turn for ticket. Caller must hold smMutex
+static void smTurnWaitLocked( unsigned ticket )
+  {
+  while( ticket != smServing )
+    pthread_cond_wait( &smTurnCond, &smMutex );
+  smOwner = pthread_self();
+  smDepth = 1;
+  }
+
+
+
+//Takes turn. Caller must hold smMutex
+static void smTurnAcquireLocked()
+  {
+  smTurnWaitLocked( smTicket++ );
+  }
+
+
+
+//Passes turn to next thread in order. Caller must hold smMutex
+static void smTurnReleaseLocked()
+  {
+  smDepth = 0;
+  smServing++;
+  pthread_cond_broadcast( &smTurnCond );
+  }
+
+
+
+//Wakes blocked tasks to test their wait functions. Caller must hold smMutex
+static void smChangeLocked()
+  {
+  smChange++;
+  pthread_cond_broadcast( &smChangeCond );
+  }
+
+
+
+static void *smPosixTaskEntry( void *param )
+  {
+  SmPosixTask task = *static_cast<SmPosixTask*>(param);
+  delete static_cast<SmPosixTask*>(param);
+
+  pthread_mutex_lock( &smMutex );
+  smTurnWaitLocked( task.mTicket );
+  pthread_mutex_unlock( &smMutex );
+
+  task.mTaskFunction( task.mArg );
+
+  //Task function returned, so task is finished
+  pthread_mutex_lock( &smMutex );
+  smChangeLocked();
+  smTurnReleaseLocked();
+  pthread_mutex_unlock( &smMutex );
+  return nullptr;
+  }
+
+
+
+extern "C" {
+
+  //!
+  //! \brief smInit        Init SaliMLib. Current thread becomes main loop task
+  //! \param stackCellSize Not used
+  //!
+  void smInit( unsigned stackCellSize )
+    {
+    (void)stackCellSize;
+    clock_gettime( CLOCK_MONOTONIC, &smStart );
+
+    //Waiting with time out uses monotonic clock
+    pthread_condattr_t attr;
+    pthread_condattr_init( &attr );
+    pthread_condattr_setclock( &attr, CLOCK_MONOTONIC );
+    pthread_cond_init( &smTurnCond, &attr );
+    pthread_cond_init( &smChangeCond, &attr );
+    pthread_condattr_destroy( &attr );
+
+    pthread_mutex_lock( &smMutex );
+    smTurnAcquireLocked();
+    pthread_mutex_unlock( &smMutex );
+    }
+
+
+
+  //!
+  //! \brief smPosixTickCount Returns count of milliseconds since smInit
+  //! \return                 Count of milliseconds
+  //!
+  int smPosixTickCount( void )
+    {
+    return static_cast<int>( smTickCount64() );
+    }
+
+
+
+  int64_t smTickCount64( void )
+    {
+    return smTimeUs() / 1000;
+    }
+
+
+
+  int64_t smTimeUs( void )
+    {
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return (smPosixNs(now) - smPosixNs(smStart)) / 1000;
+    }
+
+
+
+  //!
+  //! \brief smPortIrqDisable Takes turn, so threads which are not tasks may change state of primitives
+  //!                         as interrupts do. In task it only increments depth of turn
+  //! \return                 Always 0
+  //!
+  unsigned smPortIrqDisable( void )
+    {
+    pthread_mutex_lock( &smMutex );
+    if( smDepth && pthread_equal( smOwner, pthread_self() ) )
+      smDepth++;
+    else
+      smTurnAcquireLocked();
+    pthread_mutex_unlock( &smMutex );
+    return 0;
+    }
+
+
+
+  //!
+  //! \brief smPortIrqRestore Releases turn taken by smPortIrqDisable
+  //! \param state            Not used
+  //!
+  void smPortIrqRestore( unsigned state )
+    {
+    (void)state;
+    pthread_mutex_lock( &smMutex );
+    if( --smDepth == 0 )
+      smTurnReleaseLocked();
+    pthread_mutex_unlock( &smMutex );
+    }
+}
+
+
+
+//!
+//! \brief smTaskCreate  Creates new task as posix thread. Task runs when current task releases turn
+//! \param stackCellSize Task stack size in 32-bit cell. Stack is not less than SM_POSIX_STACK_MIN
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Not used
+//! \return              Always nullptr, task handles are not supported by this scheduler. When thread can not be
+//!                      created (stack size not accepted or no resources) task is not created
+//!
+SmTaskHandle smTaskCreate( unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  (void)critic;
+  size_t stackSize = static_cast<size_t>(stackCellSize) * 4;
+  if( stackSize < SM_POSIX_STACK_MIN ) stackSize = SM_POSIX_STACK_MIN;
+  if( stackSize < static_cast<size_t>(PTHREAD_STACK_MIN) ) stackSize = PTHREAD_STACK_MIN;
+
+  pthread_attr_t attr;
+  pthread_attr_init( &attr );
+  if( pthread_attr_setstacksize( &attr, stackSize ) == 0 ) {
+    pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
+    SmPosixTask *param = new SmPosixTask{ arg, taskFunction, 0 };
+    pthread_mutex_lock( &smMutex );
+    param->mTicket = smTicket++;
+    pthread_t thread;
+    if( pthread_create( &thread, &attr, smPosixTaskEntry, param ) != 0 ) {
+      //Ticket is given back, else turn would stop on it. No other ticket is taken while smMutex is held
+      smTicket--;
+      delete param;
+      }
+    pthread_mutex_unlock( &smMutex );
+    }
+  pthread_attr_destroy( &attr );
+  return nullptr;
+  }
+
+
+
+
+//!
+//! \brief smTaskCreate  Creates new task. Task control block belongs to scheduler, so caller-provided block is not used
+//! \param block         Not used
+//! \param stackCellSize Task stack size in 32-bit cell
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Define priority level for task
+//! \return              Always nullptr, task handles are not supported by this scheduler
+//!
+SmTaskHandle smTaskCreate( SmTaskBlock *block, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  (void)block;
+  return smTaskCreate( stackCellSize, arg, taskFunction, critic );
+  }
+
+
+
+
+//!
+//! \brief smTaskCreate  Creates new task. Scheduler allocates task stack itself, so caller-provided stack is not used
+//! \param block         Not used
+//! \param stack         Not used
+//! \param stackCellSize Task stack size in 32-bit cell
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Define priority level for task
+//! \return              Always nullptr, task handles are not supported by this scheduler
+//!
+SmTaskHandle smTaskCreate( SmTaskBlock *block, unsigned *stack, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  (void)block; (void)stack;
+  return smTaskCreate( stackCellSize, arg, taskFunction, critic );
+  }
+
+
+
+//!
+//! \brief smWaitBlock  Passes turn to other tasks and blocks until wait function returns true. Wait function is tested
+//!                     when any task passes turn, smWaitSignal called, poll period SM_POSIX_POLL_US elapsed or
+//!                     deadline comes when wait is timed
+//! \param arg          Any argument for waitFuncion
+//! \param waitFunction Pointer to wait function
+//! \param timed        When true then future is deadline of wait
+//! \param future       Deadline of wait in milliseconds since smInit
+//!
+static void smWaitBlock( void *arg, SmWaitFunction waitFunction, bool timed, int future )
+  {
+  pthread_mutex_lock( &smMutex );
+  //Task ran since it took turn, so state may be changed
+  smChangeLocked();
+  //Pass turn to other ready tasks as native scheduler does
+  smTurnReleaseLocked();
+  smTurnAcquireLocked();
+
+  while( true ) {
+    //Wait function is tested with turn but without smMutex, so it may use any library function.
+    //Generation is taken before test, so change during test is not lost
+    unsigned change = smChange;
+    pthread_mutex_unlock( &smMutex );
+    if( waitFunction(arg) ) return;
+    pthread_mutex_lock( &smMutex );
+
+    //Block until any task changes state, poll period elapsed or deadline comes
+    smTurnReleaseLocked();
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    int64_t ns = SM_POSIX_POLL_US > 0 ? smPosixNs(now) + static_cast<int64_t>(SM_POSIX_POLL_US) * 1000 : INT64_MAX;
+    if( timed ) {
+      //Deadline is start of future millisecond. When it is out but wait function is not satisfied wait one millisecond
+      int64_t tick     = smTickCount64();
+      int64_t rest     = static_cast<int>( static_cast<unsigned>(future) - static_cast<unsigned>(tick) );
+      int64_t deadline = smPosixNs(smStart) + (tick + (rest > 0 ? rest : 1)) * 1000000;
+      if( deadline < ns ) ns = deadline;
+      }
+    if( ns == INT64_MAX ) {
+      while( change == smChange )
+        pthread_cond_wait( &smChangeCond, &smMutex );
+      }
+    else {
+      struct timespec timeOut;
+      timeOut.tv_sec  = static_cast<time_t>( ns / 1000000000 );
+      timeOut.tv_nsec = static_cast<long>( ns % 1000000000 );
+      while( change == smChange )
+        if( pthread_cond_timedwait( &smChangeCond, &smMutex, &timeOut ) != 0 ) break;
+      }
+    smTurnAcquireLocked();
+    }
+  }
+
+
+
+//!
+//! \brief smWaitVoid   Main wait function. Wait while waitFuncion return true. Task passes turn to other tasks and
+//!                     blocks until its wait function returns true
+//! \param arg          Any argument for waitFuncion
+//! \param waitFunction Pointer to wait function
+//!
+void smWaitVoid( void *arg, SmWaitFunction waitFunction )
+  {
+  smWaitBlock( arg, waitFunction, false, 0 );
+  }
+
+
+
+//!
+//! \brief smWaitVoidUntil Wait function with deadline. Task blocks until state changed or future comes
+//! \param arg             Any argument for waitFuncion
+//! \param waitFunction    Pointer to wait function. It must return true not later than future comes
+//! \param future          Deadline. This value returned by function smTickFuture
+//!
+void smWaitVoidUntil( void *arg, SmWaitFunction waitFunction, int future )
+  {
+  smWaitBlock( arg, waitFunction, true, future );
+  }
+
+
+
+//!
+//! \brief smWaitSignal Wakes all blocked tasks to test their wait functions. It must be called by threads which are not
+//!                     tasks after changing of variables tested by wait functions
+//!
+void smWaitSignal()
+  {
+  pthread_mutex_lock( &smMutex );
+  smChangeLocked();
+  pthread_mutex_unlock( &smMutex );
+  }
+
+
+
+//!
+//! \brief smWaitTick Helper function for waiting specified timeOut. Task sleeps without turn until timeOut elapsed
+//! \param timeOut    Waiting time out in milliseconds
+//!
+void smWaitTick( int timeOut )
+  {
+  struct timespec future;
+  clock_gettime( CLOCK_MONOTONIC, &future );
+  int64_t ns = smPosixNs(future) + static_cast<int64_t>(timeOut < 0 ? 0 : timeOut) * 1000000;
+  future.tv_sec  = static_cast<time_t>( ns / 1000000000 );
+  future.tv_nsec = static_cast<long>( ns % 1000000000 );
+
+  pthread_mutex_lock( &smMutex );
+  smChangeLocked();
+  smTurnReleaseLocked();
+  pthread_mutex_unlock( &smMutex );
+
+  while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &future, nullptr ) != 0 );
+
+  pthread_mutex_lock( &smMutex );
+  smTurnAcquireLocked();
+  pthread_mutex_unlock( &smMutex );
+  }
+
+
+
+//!
+//! \brief smYeld Simple funtion which passes turn to other ready tasks and resume this task after them
+//!
+void smYeld()
+  {
+  smWaitVoid( nullptr, [] ( void* ) -> bool { return true; } );
+  }
+
+
+
+//!
+//! \brief smYieldTo Direct handoff is not supported by this scheduler, so it works as smYeld
+//! \param task      Not used
+//! \return          Always false
+//!
+bool smYieldTo( SmTaskHandle task )
+  {
+  (void)task;
+  smYeld();
+  return false;
+  }
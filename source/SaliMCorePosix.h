@@ -0,0 +1,30 @@
+#ifndef SALIMCOREPOSIX_H
+#define SALIMCOREPOSIX_H
+
+//Each task is posix thread, but only one of them runs at the same time: thread runs when it holds turn.
+//Turns are granted in order of request, so tasks run round robin as in native cooperative scheduler
+//and SaliM application code needs no changes
+
+extern "C" int smPosixTickCount( void );
+
+//System tick count in milliseconds from CLOCK_MONOTONIC
+#define smTickCount  smPosixTickCount()
+
+//Waiting thread blocks on condition variable, so threads which are not tasks must wake it with smWaitSignal
+#define SM_WAIT_SIGNAL 1
+
+//Period in microseconds after which blocked task tests its wait function even without state change. Timed waits of
+//library block until their own deadline, so period limits latency only of custom waits for time. When 0 blocked task
+//tests its wait function only when state changed or its deadline comes
+#ifndef SM_POSIX_POLL_US
+  #define SM_POSIX_POLL_US 1000
+#endif
+
+//Minimal stack size of task thread in bytes. Stack sizes of microcontroller tasks are too small for host code
+#ifndef SM_POSIX_STACK_MIN
+  #define SM_POSIX_STACK_MIN 65536
+#endif
+
+#include "SaliMCore.h"
+
+#endif // SALIMCOREPOSIX_H
@@ -1,6 +1,25 @@
 
 #include "SaliMCoreRTOS.h"
 
+#ifndef SM_TASK_MAX
+  #define SM_TASK_MAX 16
+#endif
+
+static TaskHandle_t smWaiters[SM_TASK_MAX]; //Tasks blocked in smWaitVoid
+
+
+
+//!
+//! \brief smMsToTicks Converts milliseconds to FreeRTOS ticks rounding up, so delay is never shorter than requested
+//! \param ms          Time in milliseconds
+//! \return            Time in ticks
+//!
+static TickType_t smMsToTicks( int ms )
+  {
+  if( ms <= 0 ) return 0;
+  return static_cast<TickType_t>( (static_cast<unsigned long long>(ms) * configTICK_RATE_HZ + 999) / 1000 );
+  }
+
 
 //!
 //! \brief smTaskCreate  Creates new task with stackCellSize stack size and taskFunctor as task entry point
@@ -9,8 +28,9 @@
 //! \param taskFunction  Task entry point function
 //! \param critic        Define priority level for task. All task devided into two sections: critic tasks and all other.
 //!                      Critic task handled as fast as possible and suit for polling tasks.
+//! \return              Always nullptr, task handles are not supported by this scheduler
 //!
-void smTaskCreate( unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+SmTaskHandle smTaskCreate( unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
   {
   static int c = 0;
   char taskName[8];
@@ -25,9 +45,105 @@ void smTaskCreate( unsigned stackCellSize, void *arg, SmTaskFunction taskFunctio
   TaskHandle_t xHandle = NULL;
   xTaskCreate( taskFunction, taskName, stackCellSize, arg, tskIDLE_PRIORITY, &xHandle );
   configASSERT( xHandle );
+  return nullptr;
+  }
+
+
+
+
+//!
+//! \brief smTaskCreate  Creates new task. Task control block belongs to scheduler, so caller-provided block is not used
+//! \param block         Not used
+//! \param stackCellSize Task stack size in 32-bit cell
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Define priority level for task
+//! \return              Always nullptr, task handles are not supported by this scheduler
+//!
+SmTaskHandle smTaskCreate( SmTaskBlock *block, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  (void)block;
+  return smTaskCreate( stackCellSize, arg, taskFunction, critic );
+  }
+
+
+
+
+//!
+//! \brief smTaskCreate  Creates new task. Scheduler allocates task stack itself, so caller-provided stack is not used
+//! \param block         Not used
+//! \param stack         Not used
+//! \param stackCellSize Task stack size in 32-bit cell
+//! \param arg           Param for task, may any or nothing
+//! \param taskFunction  Task entry point function
+//! \param critic        Define priority level for task
+//! \return              Always nullptr, task handles are not supported by this scheduler
+//!
+SmTaskHandle smTaskCreate( SmTaskBlock *block, unsigned *stack, unsigned stackCellSize, void *arg, SmTaskFunction taskFunction, bool critic )
+  {
+  (void)block; (void)stack;
+  return smTaskCreate( stackCellSize, arg, taskFunction, critic );
+  }
+
+
+//!
+//! \brief smWaitTimeOut Returns time out of one block in smWaitBlock: poll period limited by deadline
+//! \param timed         When true then future is deadline of wait
+//! \param future        Deadline of wait
+//! \param registered    When false then task is not registered as waiter, so it will not be signaled and must poll
+//! \return              Time out in ticks
+//!
+static TickType_t smWaitTimeOut( bool timed, int future, bool registered )
+  {
+  TickType_t timeOut = SM_RTOS_POLL_MS > 0 ? smMsToTicks( SM_RTOS_POLL_MS ) : portMAX_DELAY;
+  if( timeOut == 0 || !registered ) timeOut = 1;
+  if( timed ) {
+    //Deadline is already out but wait function is not yet satisfied because of tick rounding, so wait one tick
+    TickType_t rest = smMsToTicks( static_cast<int>( static_cast<unsigned>(future) - static_cast<unsigned>(smTickCount) ) );
+    if( rest == 0 ) rest = 1;
+    if( rest < timeOut ) timeOut = rest;
+    }
+  return timeOut;
+  }
+
+
+
+
+//!
+//! \brief smWaitBlock  Blocks task until wait function returns true. Task is resumed by smWaitSignal, by poll period
+//!                     or by deadline when wait is timed
+//! \param arg          Any argument for waitFuncion
+//! \param waitFunction Pointer to wait function
+//! \param timed        When true then future is deadline of wait
+//! \param future       Deadline of wait
+//!
+static void smWaitBlock( void *arg, SmWaitFunction waitFunction, bool timed, int future )
+  {
+  if( waitFunction(arg) ) return;
+
+  //Register task as waiter before test, so signal between test and block is not lost: it remains in notification count
+  int slot;
+  unsigned state = smPortIrqDisable();
+  for( slot = 0; slot < SM_TASK_MAX && smWaiters[slot] != nullptr; slot++ );
+  if( slot < SM_TASK_MAX )
+    smWaiters[slot] = xTaskGetCurrentTaskHandle();
+  smPortIrqRestore( state );
+
+  //Block until signal, deadline or poll period. When there is no free slot task only polls
+  while( !waitFunction(arg) )
+    ulTaskNotifyTake( pdTRUE, smWaitTimeOut( timed, future, slot < SM_TASK_MAX ) );
+
+  //Unregister task
+  if( slot < SM_TASK_MAX ) {
+    state = smPortIrqDisable();
+    smWaiters[slot] = nullptr;
+    smPortIrqRestore( state );
+    }
   }
 
 
+
+
 //!
 //! \brief smWaitVoid   Main wait function. Wait while waitFuncion return true. While task is in wait state cpu switch to other tasks
 //! \param arg          Any argument for waitFuncion
@@ -35,8 +151,50 @@ void smTaskCreate( unsigned stackCellSize, void *arg, SmTaskFunction taskFunctio
 //!
 void smWaitVoid( void *arg, SmWaitFunction waitFunction )
   {
-  while( !waitFunction(arg) )
-    taskYIELD();
+  smWaitBlock( arg, waitFunction, false, 0 );
+  }
+
+
+
+
+//!
+//! \brief smWaitVoidUntil Wait function with deadline. Task blocks until smWaitSignal called or future comes
+//! \param arg             Any argument for waitFuncion
+//! \param waitFunction    Pointer to wait function. It must return true not later than future comes
+//! \param future          Deadline. This value returned by function smTickFuture
+//!
+void smWaitVoidUntil( void *arg, SmWaitFunction waitFunction, int future )
+  {
+  smWaitBlock( arg, waitFunction, true, future );
+  }
+
+
+
+
+//!
+//! \brief smWaitSignal Wakes all tasks blocked in smWaitVoid to test their wait functions. It may be called from interrupt
+//!
+void smWaitSignal()
+  {
+  //Copy waiters under lock and notify them outside of lock
+  TaskHandle_t waiters[SM_TASK_MAX];
+  int count = 0;
+  unsigned state = smPortIrqDisable();
+  for( int i = 0; i < SM_TASK_MAX; i++ )
+    if( smWaiters[i] != nullptr )
+      waiters[count++] = smWaiters[i];
+  smPortIrqRestore( state );
+
+  if( SM_RTOS_IN_ISR() ) {
+    BaseType_t woken = pdFALSE;
+    for( int i = 0; i < count; i++ )
+      vTaskNotifyGiveFromISR( waiters[i], &woken );
+    portYIELD_FROM_ISR( woken );
+    }
+  else {
+    for( int i = 0; i < count; i++ )
+      xTaskNotifyGive( waiters[i] );
+    }
   }
 
 
@@ -49,7 +207,7 @@ void smWaitVoid( void *arg, SmWaitFunction waitFunction )
 //!
 void smWaitTick( int timeOut )
   {
-  vTaskDelay( timeOut / (1000 / configTICK_RATE_HZ) );
+  vTaskDelay( smMsToTicks(timeOut) );
   }
 
 
@@ -60,3 +218,93 @@ void smYeld()
   {
   taskYIELD();
   }
+
+
+
+
+//!
+//! \brief smYieldTo Direct handoff is not supported by this scheduler, so it works as smYeld
+//! \param task      Not used
+//! \return          Always false
+//!
+bool smYieldTo( SmTaskHandle task )
+  {
+  (void)task;
+  smYeld();
+  return false;
+  }
+
+
+
+
+//!
+//! \brief smPortIrqDisable Disables interrupts
+//! \return                 Previous interrupt state which must be passed to smPortIrqRestore
+//!
+unsigned smPortIrqDisable()
+  {
+  return static_cast<unsigned>( portSET_INTERRUPT_MASK_FROM_ISR() );
+  }
+
+
+
+
+//!
+//! \brief smPortIrqRestore Restores interrupt state saved by smPortIrqDisable
+//! \param state            Interrupt state returned by smPortIrqDisable
+//!
+void smPortIrqRestore( unsigned state )
+  {
+  portCLEAR_INTERRUPT_MASK_FROM_ISR( state );
+  }
+
+
+
+
+//With 16-bit ticks count round is only 65536 ticks, so rule of smTickExtend would break silently
+static_assert( sizeof(TickType_t) >= 4, "smTimeUs and smTickCount64 require 32-bit FreeRTOS ticks (configUSE_16_BIT_TICKS 0)" );
+
+//!
+//! \brief smTickExtend Returns FreeRTOS tick count extended to 64 bits. Tick count is extended on reading, so
+//!                     it must be called at least once per FreeRTOS tick count round (49 days with 1 kHz tick).
+//!                     It may be called from interrupt and with masked interrupts: extension is guarded by
+//!                     interrupt mask and tick is read by xTaskGetTickCountFromISR, because xTaskGetTickCount
+//!                     may leave critical section and unmask interrupts
+//! \return            64-bit FreeRTOS tick count
+//!
+static uint64_t smTickExtend()
+  {
+  static TickType_t lastTick;
+  static uint64_t   highTick;
+  unsigned state = smPortIrqDisable();
+  TickType_t tick = xTaskGetTickCountFromISR();
+  if( tick < lastTick ) highTick += static_cast<uint64_t>(1) << (sizeof(TickType_t) * 8);
+  lastTick = tick;
+  uint64_t tick64 = highTick + tick;
+  smPortIrqRestore( state );
+  return tick64;
+  }
+
+
+
+
+//!
+//! \brief smTickCount64 Returns 64-bit system tick count in milliseconds
+//! \return              64-bit system tick count
+//!
+int64_t smTickCount64()
+  {
+  return static_cast<int64_t>( smTickExtend() * 1000 / configTICK_RATE_HZ );
+  }
+
+
+
+
+//!
+//! \brief smTimeUs Returns 64-bit monotonic time in microseconds. In FreeRTOS resolution of time is one tick
+//! \return         Time in microseconds
+//!
+int64_t smTimeUs()
+  {
+  return static_cast<int64_t>( smTickExtend() * 1000000 / configTICK_RATE_HZ );
+  }
@@ -4,7 +4,28 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
-#define smTickCount  (static_cast<int>(xTaskGetTickCount()) * (1000 / configTICK_RATE_HZ))
+#define smTickCount  (static_cast<int>( static_cast<unsigned long long>(xTaskGetTickCount()) * 1000u / configTICK_RATE_HZ ))
+
+//Waiting task blocks on task notification, so primitives must wake it with smWaitSignal
+#define SM_WAIT_SIGNAL 1
+
+//Period in ms after which blocked task tests its wait function even without smWaitSignal. It is rounded up to whole ticks.
+//When 0 blocked task tests its wait function only when smWaitSignal called or its deadline comes, so tasks waiting for
+//events do not wake on every tick and idle task (and tickless idle) may run. Timed waits of library pass their deadline
+//to smWaitVoidUntil, so they do not need polling. Set positive period when custom wait functions test hardware
+//registers or variables changed without smWaitSignal
+#ifndef SM_RTOS_POLL_MS
+  #define SM_RTOS_POLL_MS 0
+#endif
+
+//Detects interrupt context
+#ifndef SM_RTOS_IN_ISR
+  #ifdef ESP_PLATFORM
+    #define SM_RTOS_IN_ISR() xPortInIsrContext()
+  #else
+    #define SM_RTOS_IN_ISR() xPortIsInsideInterrupt()
+  #endif
+#endif
 
 #include "SaliMCore.h"
 
@@ -0,0 +1,272 @@
+/*
+   SaliMLib - cooperative Minimal Multitasking Library for 32-bit single-core Microcontrollers
+
+
+   Author
+     Sibilev A.S.
+
+     www.salilab.ru
+     www.salilab.com
+   Description
+     Deferred binary logging.
+
+     Ring indexes are free-running counters, index of record is counter modulo SM_LOG_SIZE. Record is filled
+     outside of lock, so writer may be preempted between allocation and commit by interrupt or, on preemptive
+     backends, by other task. Each place of ring has ready flag set by commit, and record is taken only when
+     it is ready, so taker never copies record which is allocated but not filled yet.
+*/
+#include "SaliMLog.h"
+
+SM_USE_NAMESPACE
+
+
+static_assert( SM_LOG_SIZE > 1 && (SM_LOG_SIZE & (SM_LOG_SIZE - 1)) == 0, "Log size must be power of two" );
+
+static SmLogRecord       logRing[SM_LOG_SIZE];  //Ring of records
+static volatile bool     logReady[SM_LOG_SIZE]; //Flags of filled records of ring
+static volatile unsigned logHead;               //Count of taken records
+static volatile unsigned logTail;               //Count of allocated records
+static unsigned          logLost;               //Count of records lost because ring was full
+
+
+
+
+//Sets ready flag of record under lock, so filling of record is complete before flag is visible to taker
+static void logSetReady( int index )
+  {
+  SmIrqLocker locker;
+  logReady[index] = true;
+  }
+
+
+
+
+SmLogRecord *SM_NAMESPACE_PREPEND smLogAlloc()
+  {
+  SmIrqLocker locker;
+  if( logTail - logHead >= SM_LOG_SIZE ) {
+    logLost++;
+    return nullptr;
+    }
+  SmLogRecord *record = logRing + (logTail & (SM_LOG_SIZE - 1));
+  logTail = logTail + 1;
+  record->mTick = smTickCount;
+  return record;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smLogCommit( SmLogRecord *record )
+  {
+  logSetReady( static_cast<int>(record - logRing) );
+  smWaitSignal();
+  }
+
+
+
+
+bool SM_NAMESPACE_PREPEND smLogTake( SmLogRecord &record )
+  {
+  SmIrqLocker locker;
+  unsigned index = logHead & (SM_LOG_SIZE - 1);
+  //Records are taken in order of allocation, so oldest record which is not filled yet blocks following ones.
+  //Record is copied before it released, so it can not be overwritten while copying
+  if( logHead == logTail || !logReady[index] ) return false;
+  record          = logRing[index];
+  logReady[index] = false;
+  logHead         = logHead + 1;
+  return true;
+  }
+
+
+
+
+int SM_NAMESPACE_PREPEND smLogCount()
+  {
+  return static_cast<int>(logTail - logHead);
+  }
+
+
+
+
+unsigned SM_NAMESPACE_PREPEND smLogLost()
+  {
+  return logLost;
+  }
+
+
+
+
+//Outputs string padded to width. Zero padding is placed after sign
+static void logPad( void (*putChar)( char ch ), const char *str, int len, int width, bool zero, bool left )
+  {
+  if( zero && !left && *str == '-' ) {
+    putChar( *str++ );
+    len--;
+    width--;
+    }
+  if( !left )
+    for( int i = len; i < width; i++ ) putChar( zero ? '0' : ' ' );
+  for( int i = 0; i < len; i++ ) putChar( str[i] );
+  if( left )
+    for( int i = len; i < width; i++ ) putChar( ' ' );
+  }
+
+
+
+
+//Converts unsigned value to digits in reversed order. Returns count of digits
+static int logDigits( char *buf, uint32_t value, unsigned base, bool upper )
+  {
+  int len = 0;
+  do {
+    char ch = smDigitToHexLow( static_cast<int>(value % base) );
+    buf[len++] = upper && ch >= 'a' ? ch - 'a' + 'A' : ch;
+    value /= base;
+    }
+  while( value );
+  return len;
+  }
+
+
+
+
+//Converts value to text according to conversion char. Returns length of text
+static int logConvert( char *buf, char conversion, uintptr_t arg, int precision )
+  {
+  char digits[12];
+  int  len = 0;
+  int  count;
+  switch( conversion ) {
+    case 'd' :
+    case 'i' : {
+      int32_t value = static_cast<int32_t>(arg);
+      if( value < 0 ) buf[len++] = '-';
+      count = logDigits( digits, value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value), 10, false );
+      }
+      break;
+    case 'u' :
+      count = logDigits( digits, static_cast<uint32_t>(arg), 10, false );
+      break;
+    case 'x' :
+    case 'X' :
+      count = logDigits( digits, static_cast<uint32_t>(arg), 16, conversion == 'X' );
+      break;
+    case 'c' :
+      buf[0] = static_cast<char>(arg);
+      return 1;
+    case 'f' : {
+      union { uint32_t u; float f; } bits;
+      bits.u = static_cast<uint32_t>(arg);
+      float value = bits.f;
+      if( value < 0 ) { buf[len++] = '-'; value = -value; }
+      if( !(value < 4e9f) ) {
+        //Too large value or nan
+        buf[len++] = '#';
+        return len;
+        }
+      if( precision < 0 ) precision = 6;
+      if( precision > 9 ) precision = 9;
+      //Round to precision and split to integer and fraction parts
+      float scale = 1;
+      for( int i = 0; i < precision; i++ ) scale *= 10;
+      value += 0.5f / scale;
+      uint32_t integer = static_cast<uint32_t>(value);
+      uint32_t fraction = static_cast<uint32_t>( (value - integer) * scale );
+      count = logDigits( digits, integer, 10, false );
+      while( count ) buf[len++] = digits[--count];
+      if( precision ) {
+        buf[len++] = '.';
+        count = logDigits( digits, fraction, 10, false );
+        for( int i = count; i < precision; i++ ) buf[len++] = '0';
+        while( count ) buf[len++] = digits[--count];
+        }
+      return len;
+      }
+    default :
+      return 0;
+    }
+  while( count ) buf[len++] = digits[--count];
+  return len;
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smLogFormat( const SmLogRecord &record, void (*putChar)( char ch ) )
+  {
+  char     buf[24];
+  unsigned argIndex = 0;
+
+  //Tick of record
+  putChar( '[' );
+  int len = logConvert( buf, 'u', static_cast<unsigned>(record.mTick), 0 );
+  logPad( putChar, buf, len, 0, false, false );
+  putChar( ']' );
+  putChar( ' ' );
+
+  for( const char *ptr = record.mFormat; *ptr; ptr++ ) {
+    if( *ptr != '%' ) {
+      putChar( *ptr );
+      continue;
+      }
+    ptr++;
+    if( *ptr == '%' ) {
+      putChar( '%' );
+      continue;
+      }
+    //Flags, width and precision
+    bool zero = false, left = false;
+    for( ; *ptr == '0' || *ptr == '-'; ptr++ )
+      if( *ptr == '0' ) zero = true;
+      else left = true;
+    int width = 0;
+    for( ; *ptr >= '0' && *ptr <= '9'; ptr++ )
+      width = width * 10 + *ptr - '0';
+    int precision = -1;
+    if( *ptr == '.' )
+      for( precision = 0, ptr++; *ptr >= '0' && *ptr <= '9'; ptr++ )
+        precision = precision * 10 + *ptr - '0';
+    //Size modifiers are ignored, all arguments are stored with the same size
+    while( *ptr == 'l' || *ptr == 'h' || *ptr == 'z' ) ptr++;
+    if( *ptr == 0 ) break;
+    uintptr_t arg = argIndex < record.mCount ? record.mArg[argIndex] : 0;
+    argIndex++;
+
+    if( *ptr == 's' ) {
+      const char *str = reinterpret_cast<const char*>(arg);
+      if( str == nullptr ) str = "(null)";
+      int slen = 0;
+      while( str[slen] && (precision < 0 || slen < precision) ) slen++;
+      logPad( putChar, str, slen, width, false, left );
+      }
+    else if( *ptr == 'p' ) {
+      putChar( '0' );
+      putChar( 'x' );
+      len = logConvert( buf, 'x', arg, 0 );
+      logPad( putChar, buf, len, width - 2, zero, left );
+      }
+    else {
+      len = logConvert( buf, *ptr, arg, precision );
+      logPad( putChar, buf, len, width, zero, left );
+      }
+    }
+
+  putChar( '\n' );
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smLogTask( void *arg )
+  {
+  void (*putChar)( char ch ) = reinterpret_cast<void (*)( char )>(arg);
+  SmLogRecord record;
+  while(true) {
+    while( smLogTake( record ) )
+      smLogFormat( record, putChar );
+    //Wait for next record
+    smWaitVoid( nullptr, [] ( void* ) -> bool { return logReady[logHead & (SM_LOG_SIZE - 1)]; } );
+    }
+  }
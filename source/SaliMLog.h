@@ -0,0 +1,158 @@
+/*
+   SaliMLib - cooperative Minimal Multitasking Library for 32-bit single-core Microcontrollers
+
+
+   Author
+     Sibilev A.S.
+
+     www.salilab.ru
+     www.salilab.com
+   Description
+     Deferred binary logging. Log call stores only pointer to format string, smTickCount and raw
+     arguments into fixed ring of records. Records are formatted later by background task smLogTask
+     or taken raw by smLogTake and decoded on host, so log call in time-critical code costs only
+     a few stores.
+   */
+#ifndef SALIMLOG_H
+#define SALIMLOG_H
+
+#include "SaliMCore.h"
+
+//Count of records in log ring. It must be power of two
+#ifndef SM_LOG_SIZE
+  #define SM_LOG_SIZE 64
+#endif
+
+//Maximum count of arguments of one record
+#ifndef SM_LOG_ARG_MAX
+  #define SM_LOG_ARG_MAX 4
+#endif
+
+SM_BEGIN_NAMESPACE
+
+/*! \defgroup log SaliMLib Deferred binary logging
+    \ingroup CPlusPlusPart
+    @{
+
+    */
+
+//!
+//! \brief The SmLogRecord struct Record of log ring. Arguments are stored as raw values of pointer size, float as its bits
+//!
+struct SmLogRecord {
+    const char *mFormat;              //!< Format string. Its address is identifier of record for host decoder
+    int         mTick;                //!< smTickCount at moment of record
+    unsigned    mCount;               //!< Count of arguments
+    uintptr_t   mArg[SM_LOG_ARG_MAX]; //!< Raw arguments
+  };
+
+
+
+//!
+//! \brief smLogAlloc Allocates record in log ring and sets its tick. It may be called from interrupt
+//! \return           Record or nullptr when ring is full. In this case record is counted as lost
+//!
+SmLogRecord *smLogAlloc();
+
+
+
+//!
+//! \brief smLogCommit Marks record allocated by smLogAlloc as filled, so it can be taken, and signals log task.
+//!                    It may be called from interrupt
+//! \param record      Filled record
+//!
+void smLogCommit( SmLogRecord *record );
+
+
+
+//Conversion of log argument to raw value
+template <typename SmValue>
+inline uintptr_t smLogArg( SmValue value ) { return static_cast<uintptr_t>(value); }
+
+template <typename SmValue>
+inline uintptr_t smLogArg( SmValue *value ) { return reinterpret_cast<uintptr_t>(value); }
+
+inline uintptr_t smLogArg( float value ) { union { float f; uint32_t u; } bits; bits.f = value; return bits.u; }
+
+inline uintptr_t smLogArg( double value ) { return smLogArg( static_cast<float>(value) ); }
+
+inline void smLogStore( uintptr_t* ) {}
+
+template <typename SmArg, typename... SmArgs>
+inline void smLogStore( uintptr_t *dst, SmArg arg, SmArgs... args )
+  {
+  *dst = smLogArg( arg );
+  smLogStore( dst + 1, args... );
+  }
+
+
+
+//!
+//! \brief smLog  Appends record to log. Format is not processed here, so format string and string arguments must
+//!               remain valid until record formatted, usually they are literals. Format supports %d %i %u %x %X %c %s
+//!               %p %f and %% with flag 0, width and precision. Arguments wider than pointer are truncated.
+//!               When ring is full record is lost
+//! \param format printf-like format string without line end
+//! \param args   Arguments of format
+//!
+template <typename... SmArgs>
+inline void smLog( const char *format, SmArgs... args )
+  {
+  static_assert( sizeof...(args) <= SM_LOG_ARG_MAX, "Too many log arguments, increase SM_LOG_ARG_MAX" );
+  SmLogRecord *record = smLogAlloc();
+  if( record != nullptr ) {
+    record->mFormat = format;
+    record->mCount  = sizeof...(args);
+    smLogStore( record->mArg, args... );
+    smLogCommit( record );
+    }
+  }
+
+
+
+//!
+//! \brief smLogTake Takes oldest record from log ring. It used to transfer raw records to host
+//! \param record    Place to copy record to
+//! \return          true when record taken or false when ring is empty
+//!
+bool smLogTake( SmLogRecord &record );
+
+
+
+//!
+//! \brief smLogCount Returns count of records in log ring
+//! \return           Count of records
+//!
+int smLogCount();
+
+
+
+//!
+//! \brief smLogLost Returns count of records lost because ring was full
+//! \return          Count of lost records
+//!
+unsigned smLogLost();
+
+
+
+//!
+//! \brief smLogFormat Formats record as text line: tick in brackets, formatted message and line end
+//! \param record      Record to format
+//! \param putChar     Function which outputs one char, for example to UART
+//!
+void smLogFormat( const SmLogRecord &record, void (*putChar)( char ch ) );
+
+
+
+//!
+//! \brief smLogTask Log task. It waits for records and formats them to output function passed as argument, for example:
+//!                  smTaskCreate( 200, reinterpret_cast<void*>(uartPutChar), smLogTask )
+//! \param arg       Output function of type void (*)( char ch )
+//!
+void smLogTask( void *arg );
+
+//! @} log
+
+SM_END_NAMESPACE
+
+#endif // SALIMLOG_H
@@ -0,0 +1,264 @@
+/*
+   SaliMLib - cooperative Minimal Multitasking Library for 32-bit single-core Microcontrollers
+
+
+   Author
+     Sibilev A.S.
+
+     www.salilab.ru
+     www.salilab.com
+   Description
+     Command line shell.
+
+     Hashes of command names are calculated at compile time. When shell constructed, built-in and user
+     commands are placed to hash map keyed on hash of name. When line executed, only hash of first word
+     is calculated, command is taken from hash map and its name is compared once to reject words which
+     hash matches command hash by chance.
+*/
+#include "SaliMShell.h"
+
+SM_USE_NAMESPACE
+
+
+static_assert( (SM_SHELL_INDEX_SIZE & (SM_SHELL_INDEX_SIZE - 1)) == 0, "Shell index size must be power of two" );
+
+
+
+static bool shellIsSpace( char ch ) { return ch == ' ' || ch == '\t'; }
+
+
+
+static bool shellIsEqual( const char *str1, const char *str2 )
+  {
+  while( *str1 && *str1 == *str2 ) { str1++; str2++; }
+  return *str1 == *str2;
+  }
+
+
+
+
+static void shellHelp( SmShell &shell, int, char *[] );
+
+static void shellTasks( SmShell &shell, int, char *[] )
+  {
+#ifndef SM_WAIT_SIGNAL
+  //Task handles exist only in native scheduler. Enumeration includes suspended tasks, which are not in task ring
+  for( SmTaskHandle task = smTaskFirst(); task != nullptr; task = smTaskNext( task ) ) {
+    shell.print( "task " );
+    shell.printUInt( task->mId );
+    shell.print( task->mCritic ? " critic" : " normal" );
+    if( task->mSuspended ) shell.print( " suspended" );
+    shell.print( " stack " );
+    shell.printUInt( task->mStackCellSize );
+#if SM_HOG_DETECTOR
+    shell.print( " max slice " );
+    shell.printUInt( smHogMaxSlice( task->mId ) );
+    shell.print( " us" );
+#endif
+    shell.print( "\n" );
+    }
+#else
+  shell.print( "not supported\n" );
+#endif
+  }
+
+
+
+static void shellUptime( SmShell &shell, int, char *[] )
+  {
+  shell.printUInt( static_cast<uint64_t>( smTimeUs() ) );
+  shell.print( " us\n" );
+  }
+
+
+
+static void shellVersion( SmShell &shell, int, char *[] )
+  {
+  shell.print( "SaliMLib v" );
+  shell.printUInt( SM_VERSION_MAJOR );
+  shell.print( "." );
+  shell.printUInt( SM_VERSION_MINOR );
+  shell.print( "\n" );
+  }
+
+
+
+#if SM_WAKE_HISTOGRAM
+static void shellWake( SmShell &shell, int argc, char *argv[] )
+  {
+  if( argc > 1 && shellIsEqual( argv[1], "clear" ) )
+    smWakeHistogramClear();
+  else
+    smWakeHistogramDump( shell.output() );
+  }
+#endif
+
+
+
+static constexpr SmShellCommand shellBuiltIn[] = {
+  { "help",    shellHelp,    "list of commands" },
+  { "tasks",   shellTasks,   "list of tasks" },
+  { "uptime",  shellUptime,  "time since start in microseconds" },
+  { "version", shellVersion, "SaliMLib version" },
+#if SM_WAKE_HISTOGRAM
+  { "wake",    shellWake,    "wake-latency histograms, wake clear - clear them" },
+#endif
+  };
+
+SM_SHELL_CHECK( shellBuiltIn );
+
+static const int shellBuiltInCount = sizeof(shellBuiltIn) / sizeof(shellBuiltIn[0]);
+
+//Built-in table must match names used by SM_SHELL_CHECK of user tables
+static constexpr bool shellBuiltInMatch( int index = 0 )
+  {
+  return index >= shellBuiltInCount || (smShellNameEqual( shellBuiltIn[index].mName, smShellBuiltInNames[index] ) && shellBuiltInMatch( index + 1 ));
+  }
+
+static_assert( shellBuiltInCount == smShellBuiltInCount && shellBuiltInMatch(), "Built-in commands must match smShellBuiltInNames" );
+
+
+
+static void shellHelpList( SmShell &shell, const SmShellCommand *commands, int count )
+  {
+  for( int i = 0; i < count; i++ ) {
+    //Built-in command replaced by user one is not listed
+    if( shell.find( commands[i].mName ) != commands + i ) continue;
+    shell.print( commands[i].mName );
+    shell.print( " - " );
+    shell.print( commands[i].mHelp );
+    shell.print( "\n" );
+    }
+  }
+
+
+
+static void shellHelp( SmShell &shell, int, char *[] )
+  {
+  shellHelpList( shell, shellBuiltIn, shellBuiltInCount );
+  shellHelpList( shell, shell.commands(), shell.commandCount() );
+  }
+
+
+
+
+SmShell::SmShell( const SmShellCommand *commands, int count, SmShellPutChar putChar ) :
+  mCommands(commands),
+  mCount(count),
+  mPutChar(putChar),
+  mLength(0)
+  {
+  //User commands are inserted after built-in ones, so they replace built-in commands with the same name
+  for( int i = 0; i < shellBuiltInCount && mIndex.emptyCount(); i++ )
+    mIndex.insert( shellBuiltIn[i].mHash, shellBuiltIn + i );
+  for( int i = 0; i < count && mIndex.emptyCount(); i++ )
+    mIndex.insert( commands[i].mHash, commands + i );
+  }
+
+
+
+
+bool SmShell::receiv( char ch )
+  {
+  if( ch == '\r' || ch == '\n' ) {
+    mLine[mLength] = 0;
+    return true;
+    }
+  if( ch == '\b' || ch == 0x7f ) {
+    if( mLength ) mLength--;
+    }
+  //Last place is reserved for terminating zero
+  else if( mLength < SM_SHELL_LINE_SIZE - 1 )
+    mLine[mLength++] = ch;
+  return false;
+  }
+
+
+
+
+void SmShell::execute()
+  {
+  mLine[mLength] = 0;
+  mLength = 0;
+  execute( mLine );
+  }
+
+
+
+
+void SmShell::execute( char *line )
+  {
+  //Split line to arguments in place: spaces after arguments are replaced by zeros
+  char *argv[SM_SHELL_ARG_MAX];
+  int   argc = 0;
+  while( true ) {
+    while( shellIsSpace( *line ) ) line++;
+    if( *line == 0 ) break;
+    if( argc == SM_SHELL_ARG_MAX ) {
+      print( "too many arguments\n" );
+      return;
+      }
+    argv[argc++] = line;
+    while( *line && !shellIsSpace( *line ) ) line++;
+    if( *line ) *line++ = 0;
+    }
+
+  //Empty line
+  if( argc == 0 ) return;
+
+  const SmShellCommand *command = find( argv[0] );
+  if( command == nullptr ) {
+    print( "unknown command " );
+    print( argv[0] );
+    print( "\n" );
+    return;
+    }
+  command->mFunction( *this, argc, argv );
+  }
+
+
+
+
+const SmShellCommand *SmShell::find( const char *name )
+  {
+  const SmShellCommand **command = mIndex.find( smShellHash( name ) );
+  //Name is compared to reject word with the same hash
+  if( command == nullptr || !shellIsEqual( (*command)->mName, name ) )
+    return nullptr;
+  return *command;
+  }
+
+
+
+
+void SmShell::print( const char *str )
+  {
+  while( *str ) mPutChar( *str++ );
+  }
+
+
+
+
+void SmShell::printUInt( uint64_t value )
+  {
+  char buf[20];
+  int  len = 0;
+  do {
+    buf[len++] = '0' + value % 10;
+    value /= 10;
+    }
+  while( value );
+  while( len ) mPutChar( buf[--len] );
+  }
+
+
+
+
+void SmShell::printInt( int64_t value )
+  {
+  if( value < 0 ) {
+    mPutChar( '-' );
+    printUInt( 0 - static_cast<uint64_t>(value) );
+    }
+  else printUInt( static_cast<uint64_t>(value) );
+  }
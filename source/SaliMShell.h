@@ -0,0 +1,261 @@
+/*
+   SaliMLib - cooperative Minimal Multitasking Library for 32-bit single-core Microcontrollers
+
+
+   Author
+     Sibilev A.S.
+
+     www.salilab.ru
+     www.salilab.com
+   Description
+     Command line shell for debug and maintenance consoles. Line is read from fixed queue and split to
+     arguments in place without copying. Command is found by hash of its name: hashes of command table are
+     calculated at compile time and checked for uniqueness by static_assert, index from hash to command is
+     built once when shell constructed. So command lookup takes constant time independently of count of commands.
+   */
+#ifndef SALIMSHELL_H
+#define SALIMSHELL_H
+
+#include "SaliMCore.h"
+
+//Maximum length of command line in chars
+#ifndef SM_SHELL_LINE_SIZE
+  #define SM_SHELL_LINE_SIZE 80
+#endif
+
+//Maximum count of arguments including command name
+#ifndef SM_SHELL_ARG_MAX
+  #define SM_SHELL_ARG_MAX 8
+#endif
+
+//Size of command index. It must be power of two and greater than count of commands with built-in ones
+#ifndef SM_SHELL_INDEX_SIZE
+  #define SM_SHELL_INDEX_SIZE 64
+#endif
+
+SM_BEGIN_NAMESPACE
+
+/*! \defgroup shell SaliMLib Command line shell
+    \ingroup CPlusPlusPart
+    @{
+
+    */
+
+class SmShell;
+
+//!
+//! \brief SmShellFunction Command function prototype. argv[0] is command name, argv[1]...argv[argc-1] are arguments
+//!
+using SmShellFunction = void (*)( SmShell &shell, int argc, char *argv[] );
+
+//!
+//! \brief SmShellPutChar Output function prototype. It outputs one char to console
+//!
+using SmShellPutChar = void (*)( char ch );
+
+
+
+//!
+//! \brief smShellHash Calculates FNV-1a hash of string. It is constexpr, so hash of literal is calculated at compile time
+//! \param str         String to hash
+//! \param hash        Hash of previous part of string
+//! \return            Hash of string
+//!
+constexpr unsigned smShellHash( const char *str, unsigned hash = 2166136261u )
+  {
+  return *str ? smShellHash( str + 1, (hash ^ static_cast<unsigned char>(*str)) * 16777619u ) : hash;
+  }
+
+
+
+//!
+//! \brief The SmShellCommand struct Description of command. It is constructed at compile time with hash of command name
+//!
+struct SmShellCommand {
+    const char     *mName;     //!< Command name
+    unsigned        mHash;     //!< Hash of command name
+    SmShellFunction mFunction; //!< Command function
+    const char     *mHelp;     //!< Short description of command printed by help
+
+    constexpr SmShellCommand( const char *name, SmShellFunction function, const char *help = "" ) :
+      mName(name), mHash(smShellHash(name)), mFunction(function), mHelp(help) {}
+  };
+
+
+
+//Check that command at index has hash different from all following commands
+constexpr bool smShellHashUniqueAt( const SmShellCommand *commands, int count, int index, int other )
+  {
+  return other >= count || (commands[index].mHash != commands[other].mHash && smShellHashUniqueAt( commands, count, index, other + 1 ));
+  }
+
+//!
+//! \brief smShellHashUnique Check that all commands of table have different hashes. It is used by SM_SHELL_CHECK
+//! \param commands          Table of commands
+//! \param count             Count of commands in table
+//! \param index             Index of first checked command
+//! \return                  true when all hashes are unique
+//!
+constexpr bool smShellHashUnique( const SmShellCommand *commands, int count, int index = 0 )
+  {
+  return index >= count || (smShellHashUniqueAt( commands, count, index, index + 1 ) && smShellHashUnique( commands, count, index + 1 ));
+  }
+
+//Names of built-in commands. User command with the same name replaces built-in one
+constexpr const char *smShellBuiltInNames[] = {
+  "help", "tasks", "uptime", "version",
+#if SM_WAKE_HISTOGRAM
+  "wake",
+#endif
+  };
+
+//Count of built-in commands
+constexpr int smShellBuiltInCount = sizeof(smShellBuiltInNames) / sizeof(smShellBuiltInNames[0]);
+
+//Compare strings at compile time
+constexpr bool smShellNameEqual( const char *str1, const char *str2 )
+  {
+  return *str1 == *str2 && (*str1 == 0 || smShellNameEqual( str1 + 1, str2 + 1 ));
+  }
+
+//!
+//! \brief smShellBuiltInUnique Check that command does not collide with built-in command, i.e. its hash differs
+//!                            from hashes of all built-in commands or it has the same name and replaces built-in one
+//! \param command              Checked command
+//! \param index                Index of first checked built-in command
+//! \return                     true when command does not collide with built-in commands
+//!
+constexpr bool smShellBuiltInUnique( const SmShellCommand &command, int index = 0 )
+  {
+  return index >= smShellBuiltInCount ||
+         ((command.mHash != smShellHash( smShellBuiltInNames[index] ) || smShellNameEqual( command.mName, smShellBuiltInNames[index] )) &&
+          smShellBuiltInUnique( command, index + 1 ));
+  }
+
+//Check that commands of table do not collide with built-in commands
+constexpr bool smShellBuiltInUniqueAll( const SmShellCommand *commands, int count, int index = 0 )
+  {
+  return index >= count || (smShellBuiltInUnique( commands[index] ) && smShellBuiltInUniqueAll( commands, count, index + 1 ));
+  }
+
+//Compile time check of constexpr command table. Duplicated names, hash collisions between commands of table or with
+//built-in commands and table which does not fit to index are reported as compile error
+#define SM_SHELL_CHECK( commands ) \
+  static_assert( smShellHashUnique( commands, sizeof(commands) / sizeof(commands[0]) ), "Shell command names must have unique hashes" ); \
+  static_assert( smShellBuiltInUniqueAll( commands, sizeof(commands) / sizeof(commands[0]) ), "Shell command hash collides with built-in command" ); \
+  static_assert( sizeof(commands) / sizeof(commands[0]) + smShellBuiltInCount < SM_SHELL_INDEX_SIZE, "Too many shell commands, increase SM_SHELL_INDEX_SIZE" )
+
+
+
+
+//!
+//! \brief The SmShell class Command line shell. Shell reads line, splits it to arguments and calls command function.
+//!                       Besides commands of user table shell has built-in commands: help, tasks, uptime, version
+//!                       and wake (when SM_WAKE_HISTOGRAM enabled). User command with the same name replaces built-in one
+//!
+class SmShell {
+    using SmShellIndex = SmFixedHashMap<unsigned,const SmShellCommand*,SM_SHELL_INDEX_SIZE>;
+
+    const SmShellCommand *mCommands;                  //!< User command table
+    int                   mCount;                     //!< Count of user commands
+    SmShellPutChar        mPutChar;                   //!< Output function
+    int                   mLength;                    //!< Length of accumulated line
+    char                  mLine[SM_SHELL_LINE_SIZE];  //!< Accumulated line
+    SmShellIndex          mIndex;                     //!< Index of all commands by hash
+  public:
+    //!
+    //! \brief SmShell  Constructs shell and builds index of commands
+    //! \param commands Table of user commands
+    //! \param count    Count of commands in table
+    //! \param putChar  Function which outputs one char
+    //!
+    SmShell( const SmShellCommand *commands, int count, SmShellPutChar putChar );
+
+    //!
+    //! \brief SmShell  Constructs shell with array of user commands
+    //! \param commands Table of user commands
+    //! \param putChar  Function which outputs one char
+    //!
+    template <int count>
+    SmShell( const SmShellCommand (&commands)[count], SmShellPutChar putChar ) : SmShell( commands, count, putChar ) {
+      static_assert( count + smShellBuiltInCount < SM_SHELL_INDEX_SIZE, "Too many shell commands, increase SM_SHELL_INDEX_SIZE" );
+      }
+
+    //!
+    //! \brief receiv Appends char to line. Backspace removes last char, chars beyond SM_SHELL_LINE_SIZE are dropped
+    //! \param ch     Received char
+    //! \return       true when line completed by '\r' or '\n'
+    //!
+    bool receiv( char ch );
+
+    //!
+    //! \brief execute Executes accumulated line and starts new one
+    //!
+    void execute();
+
+    //!
+    //! \brief execute Splits line to arguments in place and calls command function. Empty line is ignored
+    //! \param line    Zero terminated line. It is changed by splitting
+    //!
+    void execute( char *line );
+
+    //!
+    //! \brief service Reads chars from queue until line completed and executes it. If queue is empty then it wait
+    //!                until char will be received. Usually it called in loop of shell task
+    //! \param queue   Queue of received chars, for example SmFixedQueue<char,N> filled by uart interrupt
+    //!
+    template <class SmQueue>
+    void service( SmQueue &queue ) {
+      while( !receiv( queue.deque() ) );
+      execute();
+      }
+
+    //!
+    //! \brief find Finds command by name
+    //! \param name Command name
+    //! \return     Command or nullptr when there is no command with name
+    //!
+    const SmShellCommand *find( const char *name );
+
+    //!
+    //! \brief print Outputs string
+    //! \param str   Zero terminated string
+    //!
+    void print( const char *str );
+
+    //!
+    //! \brief printUInt Outputs unsigned value in decimal
+    //! \param value     Value to output
+    //!
+    void printUInt( uint64_t value );
+
+    //!
+    //! \brief printInt Outputs signed value in decimal
+    //! \param value    Value to output
+    //!
+    void printInt( int64_t value );
+
+    //!
+    //! \brief commands Returns table of user commands
+    //! \return         Table of user commands
+    //!
+    const SmShellCommand *commands() const { return mCommands; }
+
+    //!
+    //! \brief commandCount Returns count of user commands
+    //! \return             Count of user commands
+    //!
+    int   commandCount() const { return mCount; }
+
+    //!
+    //! \brief output Returns output function
+    //! \return       Output function
+    //!
+    SmShellPutChar output() const { return mPutChar; }
+  };
+
+//! @} shell
+
+SM_END_NAMESPACE
+
+#endif // SALIMSHELL_H
@@ -0,0 +1,162 @@
+/*
+   SaliMLib - cooperative Minimal Multitasking Library for 32-bit single-core Microcontrollers
+
+
+   Author
+     Sibilev A.S.
+
+     www.salilab.ru
+     www.salilab.com
+   Description
+     Software timers on hierarchical timing wheel.
+
+     Level 0 of the wheel has slot for each of next 2^SM_TIMER_WHEEL_BITS ticks. Each slot of next level
+     covers whole round of previous level. When round of level is complete, next slot of upper level is
+     cascaded: its timers are placed to lower levels according to their expiration moments. So each timer
+     is moved at most SM_TIMER_WHEEL_LEVELS times independently of count of timers.
+*/
+#include "SaliMTimer.h"
+
+#define SM_TIMER_WHEEL_SIZE (1 << SM_TIMER_WHEEL_BITS)
+#define SM_TIMER_WHEEL_MASK (SM_TIMER_WHEEL_SIZE - 1)
+#define SM_TIMER_WHEEL_SPAN (1u << (SM_TIMER_WHEEL_BITS * SM_TIMER_WHEEL_LEVELS))
+
+static_assert( SM_TIMER_WHEEL_BITS * SM_TIMER_WHEEL_LEVELS < 32, "Timer wheel span must be less than 32 bits" );
+
+SM_USE_NAMESPACE
+
+
+static SmTimer *timerWheel[SM_TIMER_WHEEL_LEVELS][SM_TIMER_WHEEL_SIZE]; //Heads of timer lists for each slot of each level
+static int      timerTick;                                              //Next tick to be processed by timer service
+static int      timerCount;                                             //Count of armed timers
+static bool     timerService;                                           //True while timer service processes ticks
+static bool     timerFiring;                                            //True while timer service fires timers of current slot
+
+
+
+
+void SmTimer::startAt( int future, int period )
+  {
+  unlink();
+  mExpire = future;
+  mPeriod = period;
+  link();
+  }
+
+
+
+
+void SmTimer::stop()
+  {
+  unlink();
+  }
+
+
+
+
+void SmTimer::link()
+  {
+  //When there is no armed timers service does not process ticks, so synchronize wheel with current tick
+  //and wake timer task which waits for first timer
+  if( timerCount++ == 0 && !timerService ) {
+    timerTick = smTickCount;
+    smWaitSignal();
+    }
+
+  //While current slot is fired, timer armed from callback is placed to next slot. Otherwise timer restarted
+  //with zero timeout from its own callback would be fired again and again in the same slot
+  unsigned first = static_cast<unsigned>(timerTick) + (timerFiring ? 1 : 0);
+  int      delta = static_cast<int>(static_cast<unsigned>(mExpire) - first);
+  unsigned at    = static_cast<unsigned>(mExpire);
+  int      level = 0;
+  if( delta < 0 )
+    //Already expired timer is placed to first slot which will be processed
+    at = first;
+  else {
+    if( static_cast<unsigned>(delta) >= SM_TIMER_WHEEL_SPAN )
+      //Too long timer is placed to the farthest slot and will be replaced when it reached
+      at = static_cast<unsigned>(timerTick) + SM_TIMER_WHEEL_SPAN - 1;
+    //Find level which covers delta
+    while( level < SM_TIMER_WHEEL_LEVELS - 1 && static_cast<unsigned>(at - timerTick) >= (1u << (SM_TIMER_WHEEL_BITS * (level + 1))) )
+      level++;
+    }
+
+  //Insert timer at head of slot list
+  SmTimer **slot = &timerWheel[level][(at >> (SM_TIMER_WHEEL_BITS * level)) & SM_TIMER_WHEEL_MASK];
+  mNext = *slot;
+  if( mNext ) mNext->mPrev = &mNext;
+  mPrev = slot;
+  *slot = this;
+  }
+
+
+
+
+void SmTimer::unlink()
+  {
+  if( mPrev ) {
+    *mPrev = mNext;
+    if( mNext ) mNext->mPrev = mPrev;
+    mPrev = nullptr;
+    timerCount--;
+    }
+  }
+
+
+
+
+void SM_NAMESPACE_PREPEND smTimerService()
+  {
+  timerService = true;
+  while( timerCount && smTickIsOut(timerTick) ) {
+    int index = timerTick & SM_TIMER_WHEEL_MASK;
+    if( index == 0 ) {
+      //Round of level 0 complete. Cascade next slot of upper levels
+      for( int level = 1; level < SM_TIMER_WHEEL_LEVELS; level++ ) {
+        int upperIndex = (static_cast<unsigned>(timerTick) >> (SM_TIMER_WHEEL_BITS * level)) & SM_TIMER_WHEEL_MASK;
+        SmTimer *timer;
+        while( (timer = timerWheel[level][upperIndex]) != nullptr ) {
+          timer->unlink();
+          timer->link();
+          }
+        if( upperIndex != 0 ) break;
+        }
+      }
+
+    //Fire all timers of current slot. Timers are taken one by one, because callback may stop or arm any timer
+    SmTimer *timer;
+    timerFiring = true;
+    while( (timer = timerWheel[0][index]) != nullptr ) {
+      timer->unlink();
+      if( timer->mPeriod ) {
+        //Periodic timer is rearmed from its previous expiration moment, so it not drift
+        timer->mExpire = static_cast<int>(static_cast<unsigned>(timer->mExpire) + timer->mPeriod);
+        timer->link();
+        }
+      timer->mFunction( timer->mArg );
+      }
+    timerFiring = false;
+
+    timerTick = static_cast<int>(static_cast<unsigned>(timerTick) + 1);
+    }
+  timerService = false;
+  }
+
+
+
+
+//Wait function until first timer armed
+static bool timerArmed( void* ) { return timerCount && smTickIsOut(timerTick); }
+
+//Wait function for next tick. It also returns when all timers stopped, so task does not wait for tick without timers
+static bool timerNext( void* ) { return timerCount == 0 || smTickIsOut(timerTick); }
+
+void SM_NAMESPACE_PREPEND smTimerTask( void* )
+  {
+  while(true) {
+    smTimerService();
+    //Wait for next tick when there is any armed timer, otherwise wait until first timer armed
+    if( timerCount ) smWaitVoidUntil( nullptr, timerNext, timerTick );
+    else             smWaitVoid( nullptr, timerArmed );
+    }
+  }
@@ -0,0 +1,129 @@
+/*
+   SaliMLib - cooperative Minimal Multitasking Library for 32-bit single-core Microcontrollers
+
+
+   Author
+     Sibilev A.S.
+
+     www.salilab.ru
+     www.salilab.com
+   Description
+     Software timers. All timers are driven by one service task from hierarchical timing wheel
+     keyed on smTickCount. Arming, cancelling and firing of timer take constant time and do not
+     depend on count of timers. Timers are allocated by caller, so timer service uses no dynamic
+     memory.
+   */
+#ifndef SALIMTIMER_H
+#define SALIMTIMER_H
+
+#include "SaliMCore.h"
+
+//Count of bits of tick per wheel level. Each level has 2^SM_TIMER_WHEEL_BITS slots
+#ifndef SM_TIMER_WHEEL_BITS
+  #define SM_TIMER_WHEEL_BITS 6
+#endif
+
+//Count of wheel levels. Timers with timeouts up to 2^(SM_TIMER_WHEEL_BITS * SM_TIMER_WHEEL_LEVELS) ticks are placed
+//directly, longer timers are placed to the last level and replaced when it reached
+#ifndef SM_TIMER_WHEEL_LEVELS
+  #define SM_TIMER_WHEEL_LEVELS 4
+#endif
+
+SM_BEGIN_NAMESPACE
+
+/*! \defgroup timers SaliMLib Software timers
+    \ingroup CPlusPlusPart
+    @{
+
+    */
+
+//!
+//! \brief SmTimerFunction Timer callback prototype. It take one argument as pointer to void and return nothing.
+//!
+using SmTimerFunction = void (*)(void *arg);
+
+
+
+//!
+//! \brief The SmTimer class Software timer. When timer expired its callback function is called from timer service task
+//!
+class SmTimer {
+    SmTimer        *mNext;     //!< Next timer in the same wheel slot
+    SmTimer       **mPrev;     //!< Pointer to link which points to this timer (slot head or mNext of previous timer). nullptr when timer is not armed
+    int             mExpire;   //!< Tick when timer expires
+    int             mPeriod;   //!< Period for periodic timer or 0 for one-shot timer
+    SmTimerFunction mFunction; //!< Callback function
+    void           *mArg;      //!< Argument for callback function
+  public:
+    //!
+    //! \brief SmTimer Constructs not armed timer
+    //! \param function Callback function which called when timer expired
+    //! \param arg      Argument for callback function, may any or nothing
+    //!
+    SmTimer( SmTimerFunction function, void *arg = nullptr ) : mNext(nullptr), mPrev(nullptr), mExpire(0), mPeriod(0), mFunction(function), mArg(arg) {}
+
+    ~SmTimer() { stop(); }
+
+    //!
+    //! \brief isActive Check if timer is armed
+    //! \return         true when timer is armed and not yet expired (or periodic)
+    //!
+    bool isActive() const { return mPrev != nullptr; }
+
+    //!
+    //! \brief expire Returns moment when timer expires
+    //! \return       Moment when timer expires
+    //!
+    int  expire() const { return mExpire; }
+
+    //!
+    //! \brief startAt  Arms timer to expire at specified moment. If timer already armed then it rearmed
+    //! \param future   Moment in the future. This value returned by function smTickFuture
+    //! \param period   Period of timer. After first expiration timer expires every period ticks counted from future
+    //!                 moment, so periodic timer does not drift. When period is 0 timer is one-shot
+    //!
+    void startAt( int future, int period = 0 );
+
+    //!
+    //! \brief start   Arms timer to expire after tickOut elapsed. If timer already armed then it rearmed
+    //! \param tickOut Time out in ticks
+    //! \param period  Period of timer or 0 for one-shot timer
+    //!
+    void start( int tickOut, int period = 0 ) { startAt( smTickFuture(tickOut), period ); }
+
+    //!
+    //! \brief stop Cancels timer. Stopping not armed timer does nothing
+    //!
+    void stop();
+
+  private:
+    void link();
+    void unlink();
+
+    friend void smTimerService();
+  };
+
+
+
+
+//!
+//! \brief smTimerService Calls callbacks of all timers expired up to current smTickCount. It is called from smTimerTask,
+//!                       but may be called from any other loop instead of timer task
+//!
+void smTimerService();
+
+
+
+
+//!
+//! \brief smTimerTask Timer service task. It must be created once to drive timers, for example:
+//!                    smTaskCreate( 200, nullptr, smTimerTask ). Stack size must fit deepest of timer callbacks
+//! \param arg         Not used
+//!
+void smTimerTask( void *arg );
+
+//! @} timers
+
+SM_END_NAMESPACE
+
+#endif // SALIMTIMER_H
@@ -126,8 +126,332 @@ void smPackInt16(  int16_t val, uint8_t *dst );
 
 //! @} packFunctions
 
+
+
+
+/*! \defgroup crcFunctions
+    \ingroup cpart
+    \brief table-driven CRC calculation for framed protocols. Three fixed CRC models are supported:
+           - CRC-8   poly 0x07, init 0x00, no reflection, xorout 0x00 (CRC-8/SMBUS), check 0xf4
+           - CRC-16  poly 0x1021, init 0xffff, no reflection, xorout 0x0000 (CRC-16/CCITT-FALSE), check 0x29b1
+           - CRC-32  poly 0x04c11db7, init 0xffffffff, reflected, xorout 0xffffffff (CRC-32/ISO-HDLC), check 0xcbf43926
+
+           Calculation method for each model is selected at compile time with SM_CRC8_METHOD, SM_CRC16_METHOD
+           and SM_CRC32_METHOD macros according to flash budget of the target:
+           - SM_CRC_BITWISE bit at a time, no table
+           - SM_CRC_NIBBLE  4 bits at a time, 16-entry table
+           - SM_CRC_BYTE    byte at a time, 256-entry table (default)
+           - SM_CRC_SLICE8  8 bytes at a time, 8 tables by 256 entries
+
+           CRC may be calculated incrementally:
+           \code
+           uint32_t crc = SM_CRC32_INIT;
+           crc = smCrc32Update( crc, header, headerSize );
+           crc = smCrc32Update( crc, body, bodySize );
+           crc = smCrc32Final( crc );
+           \endcode
+    @{
+*/
+
+#define SM_CRC_BITWISE 0 //!< Bit at a time calculation. No table, smallest and slowest
+#define SM_CRC_NIBBLE  1 //!< Nibble at a time calculation with 16-entry table
+#define SM_CRC_BYTE    2 //!< Byte at a time calculation with 256-entry table
+#define SM_CRC_SLICE8  3 //!< Slice-by-8 calculation with 8 tables by 256 entries. Fastest and largest
+
+#ifndef SM_CRC8_METHOD
+  #define SM_CRC8_METHOD SM_CRC_BYTE
+#endif
+
+#ifndef SM_CRC16_METHOD
+  #define SM_CRC16_METHOD SM_CRC_BYTE
+#endif
+
+#ifndef SM_CRC32_METHOD
+  #define SM_CRC32_METHOD SM_CRC_BYTE
+#endif
+
+#define SM_CRC8_INIT  0x00       //!< Initial value of CRC-8 register
+#define SM_CRC16_INIT 0xffff     //!< Initial value of CRC-16 register
+#define SM_CRC32_INIT 0xffffffff //!< Initial value of CRC-32 register
+
+
+//!
+//! \brief smCrc8Update Updates CRC-8 register with block of bytes
+//! \param crc          Current CRC-8 register. For first block it must be SM_CRC8_INIT
+//! \param src          Block of bytes
+//! \param count        Count of bytes in block
+//! \return             Updated CRC-8 register
+//!
+uint8_t  smCrc8Update( uint8_t crc, const uint8_t *src, unsigned count );
+
+//!
+//! \brief smCrc8Final Converts CRC-8 register to final CRC-8 value
+//! \param crc         CRC-8 register
+//! \return            CRC-8 value
+//!
+uint8_t  smCrc8Final( uint8_t crc );
+
+//!
+//! \brief smCrc8 Calculates CRC-8 of block of bytes
+//! \param src    Block of bytes
+//! \param count  Count of bytes in block
+//! \return       CRC-8 value
+//!
+uint8_t  smCrc8( const uint8_t *src, unsigned count );
+
+
+
+
+//!
+//! \brief smCrc16Update Updates CRC-16 register with block of bytes
+//! \param crc           Current CRC-16 register. For first block it must be SM_CRC16_INIT
+//! \param src           Block of bytes
+//! \param count         Count of bytes in block
+//! \return              Updated CRC-16 register
+//!
+uint16_t smCrc16Update( uint16_t crc, const uint8_t *src, unsigned count );
+
+//!
+//! \brief smCrc16Final Converts CRC-16 register to final CRC-16 value
+//! \param crc          CRC-16 register
+//! \return             CRC-16 value
+//!
+uint16_t smCrc16Final( uint16_t crc );
+
+//!
+//! \brief smCrc16 Calculates CRC-16 of block of bytes
+//! \param src     Block of bytes
+//! \param count   Count of bytes in block
+//! \return        CRC-16 value
+//!
+uint16_t smCrc16( const uint8_t *src, unsigned count );
+
+
+
+
+//!
+//! \brief smCrc32Update Updates CRC-32 register with block of bytes
+//! \param crc           Current CRC-32 register. For first block it must be SM_CRC32_INIT
+//! \param src           Block of bytes
+//! \param count         Count of bytes in block
+//! \return              Updated CRC-32 register
+//!
+uint32_t smCrc32Update( uint32_t crc, const uint8_t *src, unsigned count );
+
+//!
+//! \brief smCrc32Final Converts CRC-32 register to final CRC-32 value
+//! \param crc          CRC-32 register
+//! \return             CRC-32 value
+//!
+uint32_t smCrc32Final( uint32_t crc );
+
+//!
+//! \brief smCrc32 Calculates CRC-32 of block of bytes
+//! \param src     Block of bytes
+//! \param count   Count of bytes in block
+//! \return        CRC-32 value
+//!
+uint32_t smCrc32( const uint8_t *src, unsigned count );
+
+//! @} crcFunctions
+
+
+
+
+/*! \defgroup formatFunctions
+    \ingroup cpart
+    \brief table-driven formatting of integer, hex, fixed-point values and hexdump lines without printf.
+           Decimal digits are produced in pairs from 100-entry table, hex digits from 16-entry table with
+           the same chars as smDigitToHexLow. Functions write text and terminating zero to destination
+           and return length of text without zero. Destination must have place for the longest text
+           of function (see SM_FORMAT_..._SIZE, sizes include terminating zero)
+    @{
+*/
+
+#define SM_FORMAT_INT_SIZE     12 //!< Size of destination for smFormatUInt and smFormatInt: "-2147483648"
+#define SM_FORMAT_HEX_SIZE     9  //!< Size of destination for smFormatHex: "ffffffff"
+#define SM_FORMAT_FIXED_SIZE   13 //!< Size of destination for smFormatFixed: "-2.147483648"
+#define SM_FORMAT_HEXDUMP_SIZE 78 //!< Size of destination for smFormatHexDump: address, 16 bytes, chars and line end
+#define SM_FORMAT_HEXDUMP_LINE 16 //!< Count of bytes in one hexdump line
+
+//!
+//! \brief smFormatUInt Formats unsigned value in decimal
+//! \param dst          Destination. It must have at least SM_FORMAT_INT_SIZE chars
+//! \param value        Value to format
+//! \return             Length of text
+//!
+int smFormatUInt( char *dst, uint32_t value );
+
+//!
+//! \brief smFormatInt Formats signed value in decimal. Negative value is preceded by '-'
+//! \param dst         Destination. It must have at least SM_FORMAT_INT_SIZE chars
+//! \param value       Value to format
+//! \return            Length of text
+//!
+int smFormatInt( char *dst, int32_t value );
+
+//!
+//! \brief smFormatHex Formats value in lower case hex without prefix
+//! \param dst         Destination. It must have at least SM_FORMAT_HEX_SIZE chars
+//! \param value       Value to format
+//! \param digits      Count of digits from 1 to 8. Value is padded with leading zeros or truncated to low digits.
+//!                    When 0 then only significant digits are formatted as with %x
+//! \return            Length of text
+//!
+int smFormatHex( char *dst, uint32_t value, int digits );
+
+//!
+//! \brief smFormatFixed Formats fixed-point value, for example value 12345 with 3 fraction digits as "12.345"
+//!                      and value -5 with 3 fraction digits as "-0.005"
+//! \param dst           Destination. It must have at least SM_FORMAT_FIXED_SIZE chars
+//! \param value         Value in units of last fraction digit
+//! \param fraction      Count of fraction digits from 0 to 9. When 0 then value is formatted as integer
+//! \return              Length of text
+//!
+int smFormatFixed( char *dst, int32_t value, int fraction );
+
+//!
+//! \brief smFormatHexDump Formats one hexdump line: 8-digit address, up to SM_FORMAT_HEXDUMP_LINE bytes in hex,
+//!                        the same bytes as chars (non-printable as '.') and line end, for example
+//!                        "00000010: 48 65 6c 6c 6f 00 .. |Hello.|\n". Missing bytes of short line are padded with spaces
+//! \param dst             Destination. It must have at least SM_FORMAT_HEXDUMP_SIZE chars
+//! \param address         Address printed at start of line
+//! \param src             Bytes of line
+//! \param count           Count of bytes. Only first SM_FORMAT_HEXDUMP_LINE bytes are formatted
+//! \return                Length of text
+//!
+int smFormatHexDump( char *dst, uint32_t address, const uint8_t *src, unsigned count );
+
+//! @} formatFunctions
+
 #ifdef __cplusplus
  };
+
+
+
+/*! \addtogroup crcFunctions
+    @{
+*/
+
+//!
+//! \brief smCrcUpdateQueue Template to update CRC register with all items of byte queue (for example SmFixedQueue<uint8_t,N>).
+//!                         Queue is not changed. Queue contents is processed as two continuous sections, so table methods
+//!                         work on the whole section without per-item overhead
+//! \param crc              Current CRC register
+//! \param queue            Queue with bytes. Queue item must be one byte size (char or uint8_t)
+//! \param update           CRC update function, one of smCrc8Update, smCrc16Update or smCrc32Update
+//! \return                 Updated CRC register
+//!
+template <typename SmCrc, class SmQueue>
+inline SmCrc smCrcUpdateQueue( SmCrc crc, SmQueue &queue, SmCrc (*update)( SmCrc, const uint8_t*, unsigned ) )
+  {
+  static_assert( sizeof(*queue.continueBuffer()) == 1, "Queue item must be one byte size" );
+  //First continuous section from head of queue
+  int count = queue.continueCount();
+  crc = update( crc, reinterpret_cast<const uint8_t*>(queue.continueBuffer()), count );
+  //Second section which wrapped to begin of queue buffer
+  if( queue.itemCount() > count )
+    crc = update( crc, reinterpret_cast<const uint8_t*>(&queue.at(count)), queue.itemCount() - count );
+  return crc;
+  }
+
+//! @} crcFunctions
+
+
+
+
+/*! \addtogroup formatFunctions
+    @{
+*/
+
+//Puts text to container with block append (for example SmFixedBuffer<char,N>)
+template <class SmBuffer>
+inline auto smFormatPut( SmBuffer &dst, char *str, int len ) -> decltype( dst.append( str, len ) )
+  {
+  dst.append( str, len );
+  }
+
+//Puts text to container with item enque (for example SmFixedQueue<char,N>)
+template <class SmQueue>
+inline auto smFormatPut( SmQueue &dst, char *str, int len ) -> decltype( dst.enque( *str ) )
+  {
+  for( int i = 0; i < len; i++ )
+    dst.enque( str[i] );
+  }
+
+//!
+//! \brief smAppendUInt Appends unsigned value in decimal to char container (SmFixedQueue<char,N> or SmFixedBuffer<char,N>).
+//!                     If container has not enough space then it waits as enque or append do
+//! \param dst          Destination container
+//! \param value        Value to append
+//!
+template <class SmContainer>
+inline void smAppendUInt( SmContainer &dst, uint32_t value )
+  {
+  char buf[SM_FORMAT_INT_SIZE];
+  smFormatPut( dst, buf, smFormatUInt( buf, value ) );
+  }
+
+//!
+//! \brief smAppendInt Appends signed value in decimal to char container
+//! \param dst         Destination container
+//! \param value       Value to append
+//!
+template <class SmContainer>
+inline void smAppendInt( SmContainer &dst, int32_t value )
+  {
+  char buf[SM_FORMAT_INT_SIZE];
+  smFormatPut( dst, buf, smFormatInt( buf, value ) );
+  }
+
+//!
+//! \brief smAppendHex Appends value in hex to char container
+//! \param dst         Destination container
+//! \param value       Value to append
+//! \param digits      Count of digits from 1 to 8 or 0 for significant digits only
+//!
+template <class SmContainer>
+inline void smAppendHex( SmContainer &dst, uint32_t value, int digits = 0 )
+  {
+  char buf[SM_FORMAT_HEX_SIZE];
+  smFormatPut( dst, buf, smFormatHex( buf, value, digits ) );
+  }
+
+//!
+//! \brief smAppendFixed Appends fixed-point value to char container
+//! \param dst           Destination container
+//! \param value         Value in units of last fraction digit
+//! \param fraction      Count of fraction digits from 0 to 9
+//!
+template <class SmContainer>
+inline void smAppendFixed( SmContainer &dst, int32_t value, int fraction )
+  {
+  char buf[SM_FORMAT_FIXED_SIZE];
+  smFormatPut( dst, buf, smFormatFixed( buf, value, fraction ) );
+  }
+
+//!
+//! \brief smAppendHexDump Appends hexdump of block to char container. Block is split to lines of SM_FORMAT_HEXDUMP_LINE bytes
+//! \param dst             Destination container
+//! \param address         Address of first byte printed at start of first line
+//! \param src             Block of bytes
+//! \param count           Count of bytes in block
+//!
+template <class SmContainer>
+inline void smAppendHexDump( SmContainer &dst, uint32_t address, const uint8_t *src, unsigned count )
+  {
+  char buf[SM_FORMAT_HEXDUMP_SIZE];
+  while( count ) {
+    unsigned line = count < SM_FORMAT_HEXDUMP_LINE ? count : SM_FORMAT_HEXDUMP_LINE;
+    smFormatPut( dst, buf, smFormatHexDump( buf, address, src, line ) );
+    address += line;
+    src     += line;
+    count   -= line;
+    }
+  }
+
+//! @} formatFunctions
+
 #endif
 
 
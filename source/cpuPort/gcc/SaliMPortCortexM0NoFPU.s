@@ -5,6 +5,10 @@
         .global  smPortInitStack
         .global  smPortBuildStack
         .global  smPortSwitchContext
+        .global  smPortIrqDisable
+        .global  smPortIrqRestore
+        .global  smPortCycleInit
+        .global  smPortCycleCount
 
         .section .text.smPortSwitchContext
 smPortSwitchContext:
@@ -79,3 +83,43 @@ smPortBuildStack:
 
         .word smTaskEntry
         .word smNextTask
+
+
+
+
+        .section .text.smPortIrqDisable
+smPortIrqDisable:
+        mrs   r0,primask        @ r0 = primask
+        cpsid i                 @ disable interrupts
+        bx    lr
+
+
+
+
+        .section .text.smPortIrqRestore
+smPortIrqRestore:
+        msr   primask,r0        @ primask = r0
+        bx    lr
+
+
+
+
+        .section .text.smPortCycleInit
+smPortCycleInit:
+        bx    lr                @ SysTick is used as cycle counter, so nothing to start
+
+
+
+
+        .section .text.smPortCycleCount
+smPortCycleCount:
+        ldr   r3,=0xE000E010    @ r3 = &SysTick->CTRL
+        ldr   r0,[r3,#4]        @ r0 = SysTick->LOAD
+        adds  r0,r0,#1          @ r0 = cycles per tick
+        ldr   r1,=smTickCount   @ r1 = &smTickCount
+        ldr   r1,[r1]           @ r1 = smTickCount
+        muls  r1,r0,r1          @ r1 = smTickCount * cycles per tick
+        ldr   r2,[r3,#8]        @ r2 = SysTick->VAL (counts down)
+        subs  r0,r0,r2          @ r0 = cycles elapsed in current tick
+        adds  r0,r0,r1          @ r0 = cycles since start
+        bx    lr
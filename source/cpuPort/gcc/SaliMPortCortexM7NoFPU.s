@@ -5,6 +5,10 @@
         .global  smPortInitStack
         .global  smPortBuildStack
         .global  smPortSwitchContext
+        .global  smPortIrqDisable
+        .global  smPortIrqRestore
+        .global  smPortCycleInit
+        .global  smPortCycleCount
 
         .section .text.smPortSwitchContext
 smPortSwitchContext:
@@ -52,3 +56,47 @@ smPortBuildStack:
 
         .word smTaskEntry
         .word smNextTask
+
+
+
+
+        .section .text.smPortIrqDisable
+smPortIrqDisable:
+        mrs   r0,primask        @ r0 = primask
+        cpsid i                 @ disable interrupts
+        bx    lr
+
+
+
+
+        .section .text.smPortIrqRestore
+smPortIrqRestore:
+        msr   primask,r0        @ primask = r0
+        bx    lr
+
+
+
+
+        .section .text.smPortCycleInit
+smPortCycleInit:
+        ldr   r0,=0xE0001FB0    @ r0 = &DWT->LAR
+        ldr   r1,=0xC5ACCE55    @ unlock DWT access
+        str   r1,[r0]
+        ldr   r0,=0xE000EDFC    @ r0 = &CoreDebug->DEMCR
+        ldr   r1,[r0]
+        orr   r1,r1,#0x01000000 @ set TRCENA to enable DWT
+        str   r1,[r0]
+        ldr   r0,=0xE0001000    @ r0 = &DWT->CTRL
+        ldr   r1,[r0]
+        orr   r1,r1,#1          @ set CYCCNTENA to start cycle counter
+        str   r1,[r0]
+        bx    lr
+
+
+
+
+        .section .text.smPortCycleCount
+smPortCycleCount:
+        ldr   r0,=0xE0001004    @ r0 = &DWT->CYCCNT
+        ldr   r0,[r0]           @ r0 = DWT->CYCCNT
+        bx    lr